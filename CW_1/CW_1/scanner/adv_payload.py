@@ -0,0 +1,170 @@
+"""Decoder for the versioned advertisement payload.
+
+The layout is specified in common/adv_payload/adv_payload.h and written by
+the C encoder used by CW_1, lab_4 and advertiser-master. Input is the
+manufacturer data after the company ID (as bleak hands it over):
+
+    version u8, group_id u8, then tag byte + value fields
+
+Field decoding is driven by FIELDS, so a new fixed-size type is one table
+entry. Length-prefixed types (0x8..0xF) that are not in the table are
+skipped, so old gateways keep working with newer firmware.
+"""
+import struct
+
+VERSION = 1
+EXT_FIRST = 0x8
+
+HISTORY_ESCAPE = 0x80
+HISTORY_MISSING = -32768
+
+STATES = {0: "NORMAL", 1: "WARNING", 2: "FAULT", 3: "DRIFT"}
+
+
+class PayloadError(ValueError):
+    pass
+
+
+def _temp(out, idx, data):
+    value = struct.unpack("<h", data)[0]
+    out["_last_temp"] = value
+    out["channels"].setdefault(idx, {})["temp_centi"] = value
+
+
+def _temp_delta(out, idx, data):
+    if "_last_temp" not in out:
+        raise PayloadError("temperature delta without a reference")
+    value = out["_last_temp"] + struct.unpack("<b", data)[0]
+    out["_last_temp"] = value
+    out["channels"].setdefault(idx, {})["temp_centi"] = value
+
+
+def _states(out, count, data):
+    for ch in range(count):
+        state = (data[ch // 4] >> (2 * (ch % 4))) & 0x3
+        out["channels"].setdefault(ch, {})["state"] = state
+
+
+def _mv(out, idx, data):
+    out["channels"].setdefault(idx, {})["mv"] = struct.unpack("<H", data)[0]
+
+
+def _flags(out, idx, data):
+    out["flags"] = data[0]
+
+
+def _history(out, channels, data):
+    """CW_1 history block (CW_1/CW_1/src/history.h), None marks a missing minute"""
+    first_minute, count = struct.unpack_from("<IB", data)
+    last = [None] * channels
+    records = []
+    pos = 5
+
+    for _ in range(count):
+        record = []
+        for ch in range(channels):
+            byte = data[pos]
+            pos += 1
+            if byte == HISTORY_ESCAPE:
+                value = struct.unpack_from("<h", data, pos)[0]
+                pos += 2
+                last[ch] = None if value == HISTORY_MISSING else value
+            elif last[ch] is None:
+                raise PayloadError("history delta without a reference")
+            else:
+                last[ch] += byte - 256 if byte & 0x80 else byte
+            record.append(last[ch])
+        records.append(record)
+
+    out.setdefault("history", []).append({"first_minute": first_minute, "records": records})
+
+
+def _minute(out, idx, data):
+    out["minute"] = struct.unpack("<I", data)[0]
+
+
+# type -> (size from the tag's low nibble, handler)
+FIELDS = {
+    0x1: (lambda idx: 2, _temp),
+    0x2: (lambda idx: 1, _temp_delta),
+    0x3: (lambda count: (count + 3) // 4, _states),
+    0x4: (lambda idx: 2, _mv),
+    0x5: (lambda idx: 1, _flags),
+    # length-prefixed
+    0x8: (None, _history),
+    0x9: (None, _minute),
+}
+
+
+def decode(data, fields=FIELDS):
+    """Returns {"version", "group_id", "flags", "channels": {ch: {...}}}
+
+    History adverts add "minute" (device minute counter) and "history", a
+    list of {"first_minute", "records"} blocks.
+
+    Raises PayloadError on an unknown version, an unknown fixed-size type or
+    a truncated field.
+    """
+    data = bytes(data)
+    if len(data) < 2:
+        raise PayloadError("payload too short")
+    if data[0] != VERSION:
+        raise PayloadError(f"unsupported payload version {data[0]}")
+
+    out = {"version": data[0], "group_id": data[1], "flags": 0, "channels": {}}
+    pos = 2
+
+    while pos < len(data):
+        tag = data[pos]
+        ftype, idx = tag >> 4, tag & 0x0F
+        pos += 1
+
+        if ftype >= EXT_FIRST:
+            if pos >= len(data):
+                raise PayloadError("truncated extension field")
+            size = data[pos]
+            pos += 1
+        elif ftype in fields:
+            size = fields[ftype][0](idx)
+        else:
+            raise PayloadError(f"unknown field type 0x{ftype:x}")
+
+        if pos + size > len(data):
+            raise PayloadError(f"truncated field type 0x{ftype:x}")
+
+        if ftype in fields:
+            try:
+                fields[ftype][1](out, idx, data[pos:pos + size])
+            except (IndexError, struct.error) as e:
+                raise PayloadError(f"malformed field type 0x{ftype:x}: {e}") from e
+        pos += size
+
+    out.pop("_last_temp", None)
+    return out
+
+
+def history_values(group_id, record):
+    """Telemetry keys for one history record (channel temperatures)"""
+    values = {}
+    for ch, temp in enumerate(record):
+        if temp is not None:
+            suffix = f"{group_id}" if ch == 0 else f"{group_id}_{ch}"
+            values[f"Temperature_{suffix}"] = temp / 100.0
+    return values
+
+
+def telemetry_values(decoded, rssi):
+    """Flattens a decoded payload into ThingsBoard telemetry keys"""
+    grp = decoded["group_id"]
+    values = {f"RSSI_{grp}": rssi}
+
+    for ch, fields in sorted(decoded["channels"].items()):
+        suffix = f"{grp}" if ch == 0 else f"{grp}_{ch}"
+        if "temp_centi" in fields:
+            values[f"Temperature_{suffix}"] = fields["temp_centi"] / 100.0
+        if "state" in fields:
+            values[f"State_{suffix}"] = STATES.get(fields["state"], "UNKNOWN")
+        if "mv" in fields:
+            values[f"Voltage_{suffix}"] = fields["mv"]
+
+    return values
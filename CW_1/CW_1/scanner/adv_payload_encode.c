@@ -0,0 +1,123 @@
+/* Host driver for the C advertisement encoder (common/adv_payload), used by
+ * test_adv_payload.py to check it against the Python decoder
+ *
+ *     cc -O2 -I../../../common/adv_payload adv_payload_encode.c \
+ *        ../../../common/adv_payload/adv_payload.c -o adv_payload_encode
+ *
+ * Reads one payload per line from stdin and prints the manufacturer data
+ * (company ID included) as hex, or "err <errno>" when the encoder failed:
+ *
+ *     <buffer size> <group id> <field>...
+ *
+ *     t <ch> <centi>          adv_payload_put_temp
+ *     s <count> <state>...    adv_payload_put_states
+ *     m <ch> <mv>             adv_payload_put_mv
+ *     f <flags>               adv_payload_put_flags
+ *     x <type> <idx> <hex>    adv_payload_put_ext ("-" for no data)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adv_payload.h"
+
+#define COMPANY_ID  0x0059
+#define LINE_MAX    4096
+
+static long next_num(char **save)
+{
+    char *tok = strtok_r(NULL, " \t\n", save);
+
+    return (tok != NULL) ? strtol(tok, NULL, 0) : 0;
+}
+
+static int put_ext(adv_payload_t *p, char **save)
+{
+    uint8_t data[255];
+    uint8_t type = (uint8_t)next_num(save);
+    uint8_t idx = (uint8_t)next_num(save);
+    char *hex = strtok_r(NULL, " \t\n", save);
+    size_t len = 0;
+
+    if (hex == NULL) {
+        return -1;
+    }
+    if (strcmp(hex, "-") != 0) {
+        for (; hex[2 * len] != '\0' && hex[2 * len + 1] != '\0' && len < sizeof(data); len++) {
+            unsigned int byte;
+
+            if (sscanf(&hex[2 * len], "%2x", &byte) != 1) {
+                return -1;
+            }
+            data[len] = (uint8_t)byte;
+        }
+    }
+    adv_payload_put_ext(p, type, idx, data, (uint8_t)len);
+    return 0;
+}
+
+int main(void)
+{
+    char line[LINE_MAX];
+
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        char *save;
+        char *tok = strtok_r(line, " \t\n", &save);
+        uint8_t buf[256];
+        adv_payload_t p;
+
+        if (tok == NULL) {
+            continue;
+        }
+
+        size_t size = strtoul(tok, NULL, 0);
+        uint8_t group = (uint8_t)next_num(&save);
+
+        if (size > sizeof(buf)) {
+            size = sizeof(buf);
+        }
+        adv_payload_init(&p, buf, size, COMPANY_ID, group);
+
+        while ((tok = strtok_r(NULL, " \t\n", &save)) != NULL) {
+            if (strcmp(tok, "t") == 0) {
+                uint8_t ch = (uint8_t)next_num(&save);
+
+                adv_payload_put_temp(&p, ch, (int16_t)next_num(&save));
+            } else if (strcmp(tok, "s") == 0) {
+                uint8_t states[16] = { 0 };
+                uint8_t count = (uint8_t)next_num(&save);
+
+                for (uint8_t c = 0; c < count && c < sizeof(states); c++) {
+                    states[c] = (uint8_t)next_num(&save);
+                }
+                adv_payload_put_states(&p, states, count);
+            } else if (strcmp(tok, "m") == 0) {
+                uint8_t ch = (uint8_t)next_num(&save);
+
+                adv_payload_put_mv(&p, ch, (int32_t)next_num(&save));
+            } else if (strcmp(tok, "f") == 0) {
+                adv_payload_put_flags(&p, (uint8_t)next_num(&save));
+            } else if (strcmp(tok, "x") == 0) {
+                if (put_ext(&p, &save) != 0) {
+                    fprintf(stderr, "bad ext field\n");
+                    return 2;
+                }
+            } else {
+                fprintf(stderr, "unknown field '%s'\n", tok);
+                return 2;
+            }
+        }
+
+        int len = adv_payload_finish(&p);
+
+        if (len < 0) {
+            printf("err %d\n", -len);
+        } else {
+            for (int i = 0; i < len; i++) {
+                printf("%02x", buf[i]);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+"""Gateway throughput benchmark.
+
+Replaces the BLE scanner with a synthetic stream of adverts from virtual
+devices and drives the real detection_callback, per-device throttling and
+upload pipeline against a local fake ThingsBoard:
+
+    python main.py --benchmark --devices 2000 --rate 5000 --duration 30
+    python main.py --benchmark --cloud-delay 0.2     # slow cloud
+
+Half of the devices send the CW_1 payload (two channel temperatures and
+states), the other half the lab_4 payload (temperature and sensor mV). Once a
+second it prints the advert rate, callback cost, upload queue depth, uploads,
+drops and the queue -> cloud latency.
+"""
+import asyncio
+import random
+import struct
+import threading
+import time
+from types import SimpleNamespace
+
+import adv_payload
+import fake_thingsboard
+
+TICK = 0.01               # generator period, seconds
+CHANGE_PROBABILITY = 0.1  # share of adverts carrying a new value
+
+
+def encode_cw1(group_id, temps, states):
+    """Same bytes as CW_1's ble_fill_payload() after the company ID"""
+    out = bytearray([adv_payload.VERSION, group_id])
+    last = None
+    for ch, temp in enumerate(temps):
+        if last is not None and -128 <= temp - last <= 127:
+            out += struct.pack("<Bb", 0x20 | ch, temp - last)
+        else:
+            out += struct.pack("<Bh", 0x10 | ch, temp)
+        last = temp
+    packed = bytearray((len(states) + 3) // 4)
+    for ch, state in enumerate(states):
+        packed[ch // 4] |= (state & 0x3) << (2 * (ch % 4))
+    out += bytes([0x30 | len(states)]) + packed
+    return bytes(out)
+
+
+def encode_lab4(group_id, temp, mv):
+    """Same bytes as lab_4's adv_fill() after the company ID"""
+    return bytes([adv_payload.VERSION, group_id]) + struct.pack("<BhBH", 0x10, temp, 0x40, mv)
+
+
+class VirtualDevice:
+    def __init__(self, index, names, company_id):
+        self.cw1 = (index % 2 == 0)
+        self.device = SimpleNamespace(
+            name=names[0] if self.cw1 else names[1],
+            address=f"02:00:{index >> 24 & 0xFF:02X}:{index >> 16 & 0xFF:02X}:"
+                    f"{index >> 8 & 0xFF:02X}:{index & 0xFF:02X}",
+        )
+        self.company_id = company_id
+        self.group_id = index % 256
+        self.temps = [random.randint(2000, 3000), random.randint(2000, 3000)]
+        self.advert = None
+        self._encode()
+
+    def _encode(self):
+        if self.cw1:
+            states = [1 if t > 2800 else 0 for t in self.temps]
+            raw = encode_cw1(self.group_id, self.temps, states)
+        else:
+            raw = encode_lab4(self.group_id, self.temps[0], (self.temps[0] + 27315) // 10)
+        self.advert = SimpleNamespace(manufacturer_data={self.company_id: raw},
+                                      rssi=random.randint(-90, -40))
+
+    def next_advert(self):
+        if random.random() < CHANGE_PROBABILITY:
+            self.temps = [t + random.randint(-20, 20) for t in self.temps]
+            self._encode()
+        return self.advert
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * p))]
+
+
+async def generate(gateway, devices, rate, duration, cost):
+    """Calls detection_callback at rate adverts/s, accumulates callback time in cost[0]"""
+    loop = asyncio.get_running_loop()
+    last = loop.time()
+    end = last + duration
+    credit = 0.0
+    index = 0
+
+    while last < end:
+        # credit from the real elapsed time, so a slow tick is made up next time
+        now = loop.time()
+        credit += rate * (now - last)
+        last = now
+        for _ in range(int(credit)):
+            device = devices[index % len(devices)]
+            index += 1
+            start = time.perf_counter()
+            gateway.detection_callback(device.device, device.next_advert())
+            cost[0] += time.perf_counter() - start
+        credit -= int(credit)
+        await asyncio.sleep(TICK)
+
+
+async def run(gateway, args):
+    """Benchmark entry point, gateway is the main.py module"""
+    server = fake_thingsboard.make_server(port=0, quiet=True, delay=args.cloud_delay)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    url = f"http://127.0.0.1:{server.server_address[1]}/api/v1"
+
+    gateway.VERBOSE = False
+    gateway.upload_queue = asyncio.Queue(maxsize=gateway.UPLOAD_QUEUE_SIZE)
+    names = ("QASIM", "Louie Lab")     # CW_1 and lab_4 device names in TARGET_NAME
+    devices = [VirtualDevice(i, names, gateway.COMPANY_ID) for i in range(args.devices)]
+    stats = gateway.stats
+    cost = [0.0]
+
+    uploader = asyncio.create_task(gateway.upload_worker(gateway.telemetry_url(url, "bench")))
+    flusher = asyncio.create_task(gateway.flush_worker())
+    generator = asyncio.create_task(generate(gateway, devices, args.rate, args.duration, cost))
+
+    print(f"Benchmark: {args.devices} devices, {args.rate:.0f} adverts/s offered, "
+          f"{args.duration:.0f} s, cloud delay {args.cloud_delay * 1000:.0f} ms")
+
+    start = time.monotonic()
+    last = (0, 0, 0.0)
+    max_depth = 0
+    try:
+        while not generator.done():
+            await asyncio.sleep(1.0)
+            depth = gateway.upload_queue.qsize()
+            max_depth = max(max_depth, depth)
+            adverts, uploaded, spent = stats.adverts, stats.uploaded, cost[0]
+            n = adverts - last[0]
+            print(f"{time.monotonic() - start:5.1f} s | adverts/s {n:6d} | "
+                  f"callback {((spent - last[2]) / n * 1e6) if n else 0:6.1f} us | "
+                  f"queue {depth:5d} | uploaded/s {uploaded - last[1]:6d} | "
+                  f"dropped {gateway.dropped_entries} | "
+                  f"latency p50 {percentile(stats.latencies, 0.5) * 1000:6.1f} ms "
+                  f"p95 {percentile(stats.latencies, 0.95) * 1000:6.1f} ms")
+            last = (adverts, uploaded, spent)
+
+        # let the uploader drain what is queued
+        drain_end = time.monotonic() + 5.0
+        while gateway.upload_queue.qsize() and time.monotonic() < drain_end:
+            await asyncio.sleep(0.1)
+        await asyncio.sleep(gateway.BATCH_WINDOW + 0.5)
+    finally:
+        generator.cancel()
+        uploader.cancel()
+        flusher.cancel()
+        server.shutdown()
+
+    elapsed = time.monotonic() - start
+    print()
+    print(f"Adverts decoded : {stats.adverts} ({stats.adverts / args.duration:.0f}/s, "
+          f"{cost[0] / max(stats.adverts, 1) * 1e6:.1f} us each, {stats.decode_errors} errors)")
+    print(f"Entries uploaded: {stats.uploaded} in {server.stats.posts} posts "
+          f"({stats.uploaded / elapsed:.0f}/s), {stats.failed_posts} failed posts")
+    print(f"Entries dropped : {gateway.dropped_entries}, max queue depth {max_depth}")
+    print(f"Upload latency  : p50 {percentile(stats.latencies, 0.5) * 1000:.1f} ms, "
+          f"p95 {percentile(stats.latencies, 0.95) * 1000:.1f} ms, "
+          f"max {max(stats.latencies, default=0) * 1000:.1f} ms")
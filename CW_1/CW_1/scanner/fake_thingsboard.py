@@ -0,0 +1,94 @@
+"""Local stand-in for the ThingsBoard HTTP telemetry API.
+
+Accepts POST /api/v1/<token>/telemetry with either a single JSON object or a
+list of {"ts": ..., "values": {...}} entries, answers 200 and prints what
+arrived. Point the gateway at it to test uploads without a cloud account:
+
+    python fake_thingsboard.py --port 8080
+    python main.py --tb-url http://127.0.0.1:8080/api/v1
+"""
+import argparse
+import json
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class TelemetryStats:
+    """Counters shared by the handler threads"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.posts = 0
+        self.entries = 0
+
+    def add(self, entries):
+        with self.lock:
+            self.posts += 1
+            self.entries += entries
+
+
+class TelemetryHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"   # keep-alive, so the gateway can reuse its connection
+
+    def do_POST(self):
+        parts = self.path.strip("/").split("/")
+        if len(parts) != 4 or parts[:2] != ["api", "v1"] or parts[3] != "telemetry":
+            self._reply(404)
+            return
+
+        length = int(self.headers.get("Content-Length", 0))
+        try:
+            body = json.loads(self.rfile.read(length))
+        except ValueError:
+            self._reply(400)
+            return
+
+        entries = body if isinstance(body, list) else [body]
+        if self.server.delay:
+            time.sleep(self.server.delay)   # stand-in for cloud round trip time
+        self.server.stats.add(len(entries))
+        if not self.server.quiet:
+            print(f"[{parts[2]}] {len(entries)} entries, "
+                  f"total {self.server.stats.entries} in {self.server.stats.posts} posts")
+        self._reply(200)
+
+    def _reply(self, status):
+        self.send_response(status)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, format, *args):
+        pass
+
+
+def make_server(host="127.0.0.1", port=8080, quiet=False, delay=0.0):
+    """Returns a ready ThreadingHTTPServer with a .stats TelemetryStats
+
+    port 0 picks a free port (server.server_address[1]), delay is added to
+    every POST to mimic a slow cloud.
+    """
+    server = ThreadingHTTPServer((host, port), TelemetryHandler)
+    server.stats = TelemetryStats()
+    server.quiet = quiet
+    server.delay = delay
+    return server
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fake ThingsBoard telemetry endpoint")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--delay", type=float, default=0.0, help="seconds added to every POST")
+    args = parser.parse_args()
+
+    server = make_server(args.host, args.port, delay=args.delay)
+    print(f"Fake ThingsBoard on http://{args.host}:{args.port}/api/v1")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
@@ -1,40 +1,142 @@
+import argparse
 import asyncio
+import collections
+import sys
 import time
-import struct
 # Import the HTTP library in order to push to Thingysboard
 import requests  
-# Import scanner 
-from bleak import BleakScanner
+
+import adv_payload
 
 # CONFIGURATION
-TARGET_NAME = {"Lab4-Adv", "LabGroup1"}
+TARGET_NAME = {"Lab4-Adv", "LabGroup1", "QASIM", "Louie Lab", "Q2TRAPPY"}
 COMPANY_ID = 0x0059 
 
 # ThingsBoard Config
 TB_URL = "https://demo.thingsboard.io/api/v1"
 TB_ACCESS_TOKEN = "yyg96elwr9hjg19hfgot"  # <--- PASTE TOKEN HERE
 
-# State variables for throttling
-last_sent_time = 0
-UPLOAD_INTERVAL = 2.0 # Send to cloud every 1 second (even if BLE is faster)
-
-def push_to_cloud(temperature, grp_id, grp_rssi):
-    """Sends JSON data to ThingsBoard via HTTP"""
-    url = f"{TB_URL}/{TB_ACCESS_TOKEN}/telemetry"
-    
-    json_key_temp = f"Temperature_{grp_id}"
-    json_key_rssi = f"RSSI_{grp_id}"    
-    
+# Per-device throttling - each (address, group_id) is tracked on its own so a
+# busy node cannot starve the others
+HEARTBEAT_INTERVAL = 60.0 # re-send an unchanged device (latest RSSI) this often, --heartbeat
+MIN_UPLOAD_GAP = 0.5      # changed payloads from one device are sent at most this often
+DEVICE_TIMEOUT = 300.0    # forget devices not heard from for this long
+
+# Upload pipeline - the BLE callback only queues telemetry, a background task
+# posts it in batches so the event loop never waits on the network
+UPLOAD_QUEUE_SIZE = 1000  # telemetry entries held while the cloud is slow
+BATCH_MAX = 100           # entries per POST
+BATCH_WINDOW = 1.0        # seconds to gather a batch after the first entry
+HTTP_TIMEOUT = 5
+
+upload_queue = None       # asyncio.Queue of (queued_at, entry), created in main()
+dropped_entries = 0
+
+VERBOSE = True            # per-advert console output, off for benchmark runs
+
+
+def debug(*args):
+    if VERBOSE:
+        print(*args)
+
+
+class GatewayStats:
+    """Counters read by the benchmark (benchmark.py)"""
+
+    def __init__(self):
+        self.adverts = 0
+        self.decode_errors = 0
+        self.uploaded = 0
+        self.failed_posts = 0
+        self.latencies = collections.deque(maxlen=10000)   # queue -> cloud ack, seconds
+
+
+stats = GatewayStats()
+
+
+class DeviceState:
+    """Latest reading of one device and what was last uploaded for it"""
+    __slots__ = ("payload", "values", "sent_payload", "last_sent", "last_seen")
+
+    def __init__(self):
+        self.payload = None       # latest raw manufacturer data
+        self.values = {}          # telemetry decoded from it, plus RSSI
+        self.sent_payload = None  # raw data of the last upload
+        self.last_sent = 0.0
+        self.last_seen = 0.0
+
+    def due(self, now):
+        """True when the latest reading should be uploaded now"""
+        if self.payload != self.sent_payload:
+            return now - self.last_sent >= MIN_UPLOAD_GAP
+        return now - self.last_sent >= HEARTBEAT_INTERVAL
+
+
+devices = {}              # (address, group_id) -> DeviceState
+
+
+# History backfill - CW_1 bursts its minute history over extended advertising,
+# records the gateway has not uploaded yet are sent with their own timestamps
+HISTORY_SEEN_MAX = 4096   # minute indexes remembered per device
+
+
+class HistoryState:
+    """Minute records already uploaded for one device"""
+    __slots__ = ("seen", "minute", "last_seen")
+
+    def __init__(self):
+        self.seen = set()
+        self.minute = 0           # device minute counter of the last burst
+        self.last_seen = 0.0
+
+
+history_devices = {}      # (address, group_id) -> HistoryState
+
+
+def backfill_history(key, decoded):
+    """Queues the history records not uploaded before, returns how many"""
+    state = history_devices.get(key)
+    if state is None:
+        state = history_devices[key] = HistoryState()
+
+    minute_now = decoded.get("minute", 0)
+    if minute_now < state.minute:
+        state.seen.clear()        # counter went backwards: the device rebooted
+    state.minute = minute_now
+    state.last_seen = time.monotonic()
+
+    now = time.time()
+    queued = 0
+    for block in decoded["history"]:
+        for i, record in enumerate(block["records"]):
+            minute = block["first_minute"] + i
+            values = adv_payload.history_values(key[1], record)
+            if minute in state.seen or not values:
+                continue
+            state.seen.add(minute)
+
+            # record n is written when minute n + 1 starts
+            ts = now - (minute_now - minute - 1) * 60
+            queue_telemetry(values, int(ts * 1000))
+            queued += 1
+
+    if len(state.seen) > HISTORY_SEEN_MAX:
+        state.seen = set(sorted(state.seen)[-HISTORY_SEEN_MAX // 2:])
+    return queued
+
+
+def telemetry_url(base_url, token):
+    return f"{base_url}/{token}/telemetry"
+
+
+def post_batch(session, url, batch):
+    """Sends a list of {"ts", "values"} entries in one POST (runs in a worker thread)"""
     # Payload format follows this JSON schema: https://thingsboard.io/docs/reference/http-api/
-    payload = {
-        json_key_temp: temperature, 
-        json_key_rssi: grp_rssi
-    }
-    
     try:
-        response = requests.post(url, json=payload, timeout=2)
+        response = session.post(url, json=batch, timeout=HTTP_TIMEOUT)
         if response.status_code == 200:
-            print(f" -> Cloud Upload Success: {payload}")
+            debug(f" -> Cloud Upload Success: {len(batch)} entries")
+            return True
         elif response.status_code == 400:
             print(f"Invalid URL, request parameters of body")
         elif response.status_code == 404:
@@ -43,55 +145,174 @@ def push_to_cloud(temperature, grp_id, grp_rssi):
             print(f" -> Cloud Error: {response.status_code}")
     except Exception as e:
         print(f" -> Cloud Connection Failed: {e}")
+    return False
+
+
+def flush_device(key, state, now):
+    queue_telemetry(state.values)
+    state.sent_payload = state.payload
+    state.last_sent = now
+
+
+async def flush_worker():
+    """Uploads readings held back by the per-device limits and drops silent devices"""
+    while True:
+        await asyncio.sleep(MIN_UPLOAD_GAP)
+        now = time.monotonic()
+
+        for key, state in list(devices.items()):
+            if now - state.last_seen >= DEVICE_TIMEOUT:
+                del devices[key]
+            elif state.last_seen > state.last_sent and state.due(now):
+                flush_device(key, state, now)
+
+        for key, state in list(history_devices.items()):
+            if now - state.last_seen >= DEVICE_TIMEOUT:
+                del history_devices[key]
+
+
+def queue_telemetry(values, ts=None):
+    """Queues one reading for upload, dropping the oldest when the queue is full"""
+    global dropped_entries
+
+    entry = {
+        "ts": int(time.time() * 1000) if ts is None else ts,
+        "values": values,
+    }
+
+    if upload_queue.full():
+        upload_queue.get_nowait()
+        upload_queue.task_done()
+        dropped_entries += 1
+    upload_queue.put_nowait((time.monotonic(), entry))
+
+
+async def upload_worker(url):
+    """Drains upload_queue, one POST per batch over a kept-alive connection"""
+    loop = asyncio.get_running_loop()
+
+    with requests.Session() as session:
+        while True:
+            batch = [await upload_queue.get()]
+            deadline = loop.time() + BATCH_WINDOW
+
+            while len(batch) < BATCH_MAX:
+                remaining = deadline - loop.time()
+                if remaining <= 0:
+                    break
+                try:
+                    batch.append(await asyncio.wait_for(upload_queue.get(), remaining))
+                except asyncio.TimeoutError:
+                    break
+
+            ok = await asyncio.to_thread(post_batch, session, url, [entry for _, entry in batch])
+
+            done = time.monotonic()
+            if ok:
+                stats.uploaded += len(batch)
+                stats.latencies.extend(done - queued_at for queued_at, _ in batch)
+            else:
+                stats.failed_posts += 1
+
+            for _ in batch:
+                upload_queue.task_done()
+
+            if dropped_entries:
+                debug(f" -> {dropped_entries} entries dropped while the cloud was behind")
+
 
 def detection_callback(device, advertisement_data):
-    global last_sent_time
-    
     if device.name and device.name in TARGET_NAME:
         if COMPANY_ID in advertisement_data.manufacturer_data:
-            
+
+            stats.adverts += 1
+
             # This allows you to debug and observe the raw data from your BLE packet
             raw_packet = advertisement_data.manufacturer_data
-            print(raw_packet)
-            
+            debug(raw_packet)
+
             # We only want the data after the company ID part 
             raw_bytes = advertisement_data.manufacturer_data[COMPANY_ID]
-            print(f"Actual data payload in HEX is: {raw_bytes.hex(' ')}")
-            
+            debug(f"Actual data payload in HEX is: {raw_bytes.hex(' ')}")
+
             try:
-                # 1. Decode BLE: refer to https://docs.python.org/3/library/struct.html, Section: Format Characters
-                unpacked = struct.unpack("<hB", raw_bytes)
+                # 1. Decode BLE: versioned payload, see adv_payload.py
+                decoded = adv_payload.decode(raw_bytes)
 
-                temperature_c = unpacked[0] / 100.0 # Convert to float
-                group_id = unpacked[1]
+                group_id = decoded["group_id"]
                 current_rssi = advertisement_data.rssi
-                
-                if group_id < 0:
-                    print(f"Error: Group ID {group_id} is out of bounds from device {device.name}")
+
+                if "history" in decoded:
+                    queued = backfill_history((device.address, group_id), decoded)
+                    debug(f"[{device.address}] History burst from Group {group_id:d}: {queued} new records")
                     return
-                
+
+                values = adv_payload.telemetry_values(decoded, current_rssi)
+
                 # Print real-time to console
-                print(f"[{device.address}] BLE Rx: {temperature_c:.2f} °C from Group {group_id:d} with RSSI {current_rssi:d}")     
-                
-                # 2. Upload to Cloud (Throttled)
-                current_time = time.time()
-                if (current_time - last_sent_time) >= UPLOAD_INTERVAL:
-                    push_to_cloud(temperature_c, group_id, current_rssi)
-                    last_sent_time = current_time
-                    
+                debug(f"[{device.address}] BLE Rx from Group {group_id:d} with RSSI {current_rssi:d}: {values}")
+
+                # 2. Queue for the cloud (Throttled per device, the rest is left to flush_worker)
+                key = (device.address, group_id)
+                state = devices.get(key)
+                if state is None:
+                    state = devices[key] = DeviceState()
+
+                now = time.monotonic()
+                state.payload = bytes(raw_bytes)
+                state.values = values
+                state.last_seen = now
+
+                if state.due(now):
+                    flush_device(key, state, now)
+
             except Exception as e:
+                stats.decode_errors += 1
                 print(f"Error: {e}")
         else:
             print(f"Warning: Company ID mismatch...")
 
-async def main():
+async def main(args):
+    global upload_queue
+
+    # Imported here so --benchmark runs without bleak installed
+    from bleak import BleakScanner
+
+    upload_queue = asyncio.Queue(maxsize=UPLOAD_QUEUE_SIZE)
+    uploader = asyncio.create_task(upload_worker(telemetry_url(args.tb_url, args.token)))
+    flusher = asyncio.create_task(flush_worker())
+
     print(f"Starting Gateway for {TARGET_NAME}...")
     scanner = BleakScanner(detection_callback=detection_callback, scanning_mode='active')
     await scanner.start()
-    await asyncio.Event().wait()
+    try:
+        await asyncio.Event().wait()
+    finally:
+        await scanner.stop()
+        uploader.cancel()
+        flusher.cancel()
 
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="BLE to ThingsBoard gateway")
+    parser.add_argument("--tb-url", default=TB_URL,
+                        help="ThingsBoard API base, e.g. http://127.0.0.1:8080/api/v1 for fake_thingsboard.py")
+    parser.add_argument("--token", default=TB_ACCESS_TOKEN)
+    parser.add_argument("--heartbeat", type=float, default=HEARTBEAT_INTERVAL,
+                        help="seconds between uploads of a device whose payload has not changed")
+    parser.add_argument("--benchmark", action="store_true",
+                        help="feed synthetic adverts into a local fake ThingsBoard instead of scanning")
+    parser.add_argument("--devices", type=int, default=1000, help="benchmark: virtual devices")
+    parser.add_argument("--rate", type=float, default=2000, help="benchmark: adverts per second offered")
+    parser.add_argument("--duration", type=float, default=20, help="benchmark: seconds to run")
+    parser.add_argument("--cloud-delay", type=float, default=0.0,
+                        help="benchmark: seconds the fake ThingsBoard takes per POST")
+    args = parser.parse_args()
+    HEARTBEAT_INTERVAL = args.heartbeat
     try:
-        asyncio.run(main())
+        if args.benchmark:
+            import benchmark
+            asyncio.run(benchmark.run(sys.modules[__name__], args))
+        else:
+            asyncio.run(main(args))
     except KeyboardInterrupt:
-        print("\nStopping Gateway...")
\ No newline at end of file
+        print("\nStopping Gateway...")
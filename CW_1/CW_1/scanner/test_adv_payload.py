@@ -0,0 +1,215 @@
+"""Round-trip and fuzz tests of the C payload encoder against adv_payload.py
+
+    python -m unittest test_adv_payload     # from CW_1/CW_1/scanner
+
+The encoder side is common/adv_payload/adv_payload.c driven through
+adv_payload_encode.c, built with the host C compiler (cc, or $CC) into a
+temporary directory. The round-trip tests are skipped when there is no
+compiler; the decoder-only tests always run.
+"""
+import os
+import random
+import shutil
+import struct
+import subprocess
+import tempfile
+import unittest
+
+import adv_payload
+from adv_payload import PayloadError, decode
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+COMMON = os.path.normpath(os.path.join(HERE, "..", "..", "..", "common", "adv_payload"))
+
+ENOMEM = 12
+EINVAL = 22
+FUZZ_PAYLOADS = 2000
+
+
+def build_encoder(outdir):
+    cc = os.environ.get("CC") or shutil.which("cc") or shutil.which("gcc")
+    if cc is None:
+        return None
+    exe = os.path.join(outdir, "adv_payload_encode")
+    subprocess.run([cc, "-O2", "-Wall", "-I", COMMON,
+                    os.path.join(HERE, "adv_payload_encode.c"),
+                    os.path.join(COMMON, "adv_payload.c"), "-o", exe],
+                   check=True)
+    return exe
+
+
+def payload(*fields, group_id=1, version=adv_payload.VERSION):
+    return bytes([version, group_id]) + b"".join(fields)
+
+
+class EncoderRoundTrip(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.TemporaryDirectory()
+        cls.exe = build_encoder(cls.tmp.name)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.tmp.cleanup()
+
+    def setUp(self):
+        if self.exe is None:
+            self.skipTest("no host C compiler")
+
+    def encode(self, lines):
+        """One encoder input line per payload -> bytes after the company ID, or errno"""
+        res = subprocess.run([self.exe], input="\n".join(lines) + "\n",
+                             capture_output=True, text=True, check=True)
+        out = []
+        for line in res.stdout.splitlines():
+            if line.startswith("err "):
+                out.append(int(line[4:]))
+            else:
+                data = bytes.fromhex(line)
+                self.assertEqual(struct.unpack_from("<H", data)[0], 0x0059)
+                out.append(data[2:])
+        self.assertEqual(len(out), len(lines))
+        return out
+
+    def test_delta_limits_and_absolute_fallback(self):
+        temps = [2500, 2627, 2500, 2372, 2500, 2372 + 256, -4000, 10000]
+        data, = self.encode(["64 7 " + " ".join(f"t {ch} {t}" for ch, t in enumerate(temps))])
+
+        tags = []
+        pos = 2
+        while pos < len(data):
+            tags.append(data[pos] >> 4)
+            pos += 3 if data[pos] >> 4 == 0x1 else 2
+        # +127, -127 and -128 fit an i8, +128 and the larger jumps do not
+        self.assertEqual(tags, [0x1, 0x2, 0x2, 0x2, 0x1, 0x1, 0x1, 0x1])
+
+        out = decode(data)
+        self.assertEqual(out["group_id"], 7)
+        self.assertEqual({ch: v["temp_centi"] for ch, v in out["channels"].items()},
+                         dict(enumerate(temps)))
+
+    def test_fuzz_round_trip(self):
+        rnd = random.Random(1)
+        lines = []
+        expected = []
+
+        for _ in range(FUZZ_PAYLOADS):
+            group_id = rnd.randrange(256)
+            fields = []
+            channels = {}
+            flags = 0
+            temp = rnd.randrange(-4000, 10001)
+
+            for ch in rnd.sample(range(16), rnd.randint(0, 6)):
+                # mostly small steps, now and then one that overflows the delta
+                temp += rnd.choice([rnd.randint(-128, 127), rnd.randint(-3000, 3000)])
+                temp = max(-32768, min(32767, temp))
+                fields.append(f"t {ch} {temp}")
+                channels.setdefault(ch, {})["temp_centi"] = temp
+                if rnd.random() < 0.5:
+                    mv = rnd.randint(-100, 70000)
+                    fields.append(f"m {ch} {mv}")
+                    channels[ch]["mv"] = max(0, min(65535, mv))
+
+            if rnd.random() < 0.7:
+                states = [rnd.randrange(4) for _ in range(rnd.randint(1, 15))]
+                fields.append(f"s {len(states)} " + " ".join(map(str, states)))
+                for ch, state in enumerate(states):
+                    channels.setdefault(ch, {})["state"] = state
+            if rnd.random() < 0.5:
+                flags = rnd.randrange(256)
+                fields.append(f"f {flags}")
+            if rnd.random() < 0.3:
+                # unknown extension types are skipped by the decoder
+                ext = bytes(rnd.randrange(256) for _ in range(rnd.randint(0, 8)))
+                fields.append(f"x {rnd.randint(0xA, 0xF)} {rnd.randrange(16)} {ext.hex() or '-'}")
+
+            rnd.shuffle(fields)
+            # shuffling changes which temperatures go out as deltas, not
+            # the decoded values
+            lines.append(f"255 {group_id} " + " ".join(fields))
+            expected.append({"version": adv_payload.VERSION, "group_id": group_id,
+                             "flags": flags, "channels": channels})
+
+        for i, (data, want) in enumerate(zip(self.encode(lines), expected)):
+            with self.subTest(payload=i, line=lines[i]):
+                self.assertIsInstance(data, bytes)
+                self.assertEqual(decode(data), want)
+
+    def test_truncation_of_encoded_payloads(self):
+        data, = self.encode(["64 3 t 0 2500 t 1 2400 s 5 0 1 2 3 1 m 0 2982 f 5 x 9 0 78563412"])
+        self.assertEqual(decode(data)["minute"], 0x12345678)
+
+        # every cut either ends on a field boundary or is reported as truncated
+        boundaries = {2, 5, 7, 10, 13, 15}
+        for cut in range(len(data)):
+            with self.subTest(cut=cut):
+                if cut in boundaries:
+                    decode(data[:cut])
+                else:
+                    with self.assertRaises(PayloadError):
+                        decode(data[:cut])
+
+    def test_encoder_errors(self):
+        out = self.encode([
+            "4 1",                      # header only
+            "5 1 t 0 2500",             # no room for the temperature
+            "6 1 t 0 2500 t 1 2501",    # sticky: the delta does not fit either
+            "64 1 t 16 2500",
+            "64 1 s 0",
+            "64 1 s 16 0",
+            "64 1 x 7 0 -",             # not an extension type
+            "64 1 t 16 2500 f 1",       # first error wins
+        ])
+        self.assertEqual(out, [b"\x01\x01", ENOMEM, ENOMEM, EINVAL, EINVAL, EINVAL, EINVAL, EINVAL])
+
+
+class DecoderErrors(unittest.TestCase):
+    def test_wrong_version(self):
+        for version in (0, 2, 0xFF):
+            with self.subTest(version=version), self.assertRaises(PayloadError):
+                decode(payload(b"\x10\xc4\x09", version=version))
+
+    def test_too_short(self):
+        for data in (b"", b"\x01"):
+            with self.assertRaises(PayloadError):
+                decode(data)
+
+    def test_unknown_fixed_type(self):
+        for ftype in (0x0, 0x6, 0x7):
+            with self.subTest(ftype=ftype), self.assertRaises(PayloadError):
+                decode(payload(bytes([ftype << 4, 0, 0])))
+
+    def test_unknown_extension_is_skipped(self):
+        out = decode(payload(b"\xa3\x03abc", b"\x10\xc4\x09", b"\xf0\x00"))
+        self.assertEqual(out["channels"], {0: {"temp_centi": 2500}})
+
+    def test_truncated_extension(self):
+        with self.assertRaises(PayloadError):
+            decode(payload(b"\xa0"))
+        with self.assertRaises(PayloadError):
+            decode(payload(b"\xa0\x04abc"))
+
+    def test_delta_without_reference(self):
+        with self.assertRaises(PayloadError):
+            decode(payload(b"\x20\x05"))
+
+    def test_malformed_history(self):
+        # count says one record of two channels, the data ends after one
+        block = struct.pack("<IB", 10, 1) + b"\x80\xc4\x09"
+        with self.assertRaises(PayloadError):
+            decode(payload(bytes([0x82, len(block)]) + block))
+
+    def test_random_bytes_only_raise_payload_error(self):
+        rnd = random.Random(2)
+        for _ in range(20000):
+            data = bytes([adv_payload.VERSION, 0]) + bytes(
+                rnd.randrange(256) for _ in range(rnd.randint(0, 24)))
+            try:
+                decode(data)
+            except PayloadError:
+                pass
+
+
+if __name__ == "__main__":
+    unittest.main()
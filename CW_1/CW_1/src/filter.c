@@ -0,0 +1,158 @@
+/* CW_1 decimation filters, see filter.h */
+#include "filter.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if DECIMATE_FACTOR < 1 || DECIMATE_FACTOR > 255
+#error "DECIMATE_FACTOR must fit the uint8_t input count"
+#endif
+
+// CIC gain is DECIMATE_FACTOR^CIC_ORDER, the full-scale output
+// (int16 * gain) has to fit the integrator width (filter.h)
+#define CIC_GAIN ((int32_t)DECIMATE_FACTOR * DECIMATE_FACTOR * DECIMATE_FACTOR)
+
+_Static_assert((uint64_t)CIC_GAIN <= ((cic_acc_t)-1 >> 16),
+               "CIC integrators too narrow for DECIMATE_FACTOR");
+
+#if DECIMATE_FACTOR != 10 && defined(CONFIG_CW1_FILTER_FIR)
+#error "fir_taps are designed for DECIMATE_FACTOR 10, regenerate them"
+#endif
+
+#if CIC_ORDER != 3
+#error "CIC_GAIN assumes a 3rd order CIC"
+#endif
+
+// Hamming-windowed sinc, cutoff at the output Nyquist (0.05 fs for a
+// decimation of 10), Q15 with a DC gain of exactly 32768
+static const int16_t fir_taps[FIR_TAPS] = {
+      -58,   -64,   -74,   -74,   -39,    57,   239,   521,   903,  1367,
+     1878,  2385,  2832,  3166,  3345,  3345,  3166,  2832,  2385,  1878,
+     1367,   903,   521,   239,    57,   -39,   -74,   -74,   -64,   -58,
+};
+
+// Rounds to nearest, halves away from zero
+static int16_t div_round(int32_t num, int32_t den)
+{
+    return (int16_t)((num >= 0) ? (num + den / 2) / den : (num - den / 2) / den);
+}
+
+#if DECIMATE_FACTOR > CIC_R_MAX_32
+static int16_t div_round64(int64_t num, int32_t den)
+{
+    return (int16_t)((num >= 0) ? (num + den / 2) / den : (num - den / 2) / den);
+}
+#endif
+
+void decim_filter_init(decim_filter_t *f, decim_filter_type_t type)
+{
+    memset(f, 0, sizeof(*f));
+    f->type = (type < DECIM_FILTER_COUNT) ? type : DECIM_FILTER_BOXCAR;
+
+    if (f->type == DECIM_FILTER_CIC) {
+        f->cic.warmup = CIC_ORDER - 1;
+    }
+}
+
+static bool boxcar_push(decim_filter_t *f, int16_t in, int16_t *out)
+{
+    f->boxcar.sum += in;
+
+    if (++f->count < DECIMATE_FACTOR) {
+        return false;
+    }
+
+    *out = (int16_t)(f->boxcar.sum / DECIMATE_FACTOR);
+    f->boxcar.sum = 0;
+    f->count = 0;
+    return true;
+}
+
+static bool cic_push(decim_filter_t *f, int16_t in, int16_t *out)
+{
+    cic_acc_t *integ = f->cic.integ;
+
+    // integrators at the input rate
+    integ[0] += (cic_acc_t)(cic_sacc_t)in;
+    for (int k = 1; k < CIC_ORDER; k++) {
+        integ[k] += integ[k - 1];
+    }
+
+    if (++f->count < DECIMATE_FACTOR) {
+        return false;
+    }
+    f->count = 0;
+
+    // combs at the output rate
+    cic_acc_t y = integ[CIC_ORDER - 1];
+    for (int k = 0; k < CIC_ORDER; k++) {
+        cic_acc_t prev = f->cic.comb[k];
+
+        f->cic.comb[k] = y;
+        y -= prev;
+    }
+
+    if (f->cic.warmup > 0) {
+        f->cic.warmup--;
+        return false;
+    }
+
+#if DECIMATE_FACTOR > CIC_R_MAX_32
+    *out = div_round64((cic_sacc_t)y, CIC_GAIN);
+#else
+    *out = div_round((cic_sacc_t)y, CIC_GAIN);
+#endif
+    return true;
+}
+
+static bool fir_push(decim_filter_t *f, int16_t in, int16_t *out)
+{
+    // start from a history filled with the first sample, so the first
+    // outputs are not pulled towards zero
+    if (!f->fir.primed) {
+        for (int k = 0; k < FIR_TAPS; k++) {
+            f->fir.history[k] = in;
+        }
+        f->fir.primed = true;
+    }
+
+    f->fir.history[f->fir.head] = in;
+    f->fir.head = (f->fir.head + 1 == FIR_TAPS) ? 0 : f->fir.head + 1;
+
+    if (++f->count < DECIMATE_FACTOR) {
+        return false;
+    }
+    f->count = 0;
+
+    // only every DECIMATE_FACTOR-th output is kept, so only that one is
+    // computed; head is now the oldest sample
+    int32_t acc = 0;
+    uint8_t idx = f->fir.head;
+
+    for (int k = 0; k < FIR_TAPS; k++) {
+        acc += (int32_t)fir_taps[k] * f->fir.history[idx];
+        idx = (idx + 1 == FIR_TAPS) ? 0 : idx + 1;
+    }
+
+    *out = div_round(acc, 32768);
+    return true;
+}
+
+bool decim_filter_push(decim_filter_t *f, int16_t in, int16_t *out)
+{
+    switch (f->type) {
+    case DECIM_FILTER_CIC: return cic_push(f, in, out);
+    case DECIM_FILTER_FIR: return fir_push(f, in, out);
+    default:               return boxcar_push(f, in, out);
+    }
+}
+
+const char *decim_filter_name(decim_filter_type_t type)
+{
+    switch (type) {
+    case DECIM_FILTER_BOXCAR: return "boxcar";
+    case DECIM_FILTER_CIC:    return "cic";
+    case DECIM_FILTER_FIR:    return "fir";
+    default:                  return "unknown";
+    }
+}
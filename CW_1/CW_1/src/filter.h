@@ -0,0 +1,73 @@
+/* CW_1 decimation filters - turn DECIMATE_FACTOR samples into one value
+ * for the rolling average. No Zephyr dependencies, like processing.c, so
+ * tools/filter_bench.c can run every filter on the host.
+ *
+ *   BOXCAR  mean of the last DECIMATE_FACTOR samples (original behaviour)
+ *   CIC     3rd order CIC decimator, better alias rejection for the same
+ *           cost, no multiplications
+ *   FIR     30-tap Q15 low-pass FIR evaluated once per output (polyphase)
+ */
+#ifndef CW1_FILTER_H
+#define CW1_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef DECIMATE_FACTOR
+#ifdef CONFIG_CW1_DECIMATE_FACTOR
+#define DECIMATE_FACTOR CONFIG_CW1_DECIMATE_FACTOR
+#else
+#define DECIMATE_FACTOR 10
+#endif
+#endif
+
+#define CIC_ORDER       3
+
+// The CIC integrators need 16 + CIC_ORDER * log2(DECIMATE_FACTOR) bits to
+// wrap correctly: 32 up to a decimation of 40, 64 above
+#define CIC_R_MAX_32    40
+#if DECIMATE_FACTOR <= CIC_R_MAX_32
+typedef uint32_t cic_acc_t;
+typedef int32_t  cic_sacc_t;
+#else
+typedef uint64_t cic_acc_t;
+typedef int64_t  cic_sacc_t;
+#endif
+#define FIR_TAPS        30   // taps in filter.c are designed for DECIMATE_FACTOR 10
+
+typedef enum {
+    DECIM_FILTER_BOXCAR = 0,
+    DECIM_FILTER_CIC,
+    DECIM_FILTER_FIR,
+    DECIM_FILTER_COUNT
+} decim_filter_type_t;
+
+typedef struct {
+    decim_filter_type_t type;
+    uint8_t count;               // inputs since the last output
+    union {
+        struct {
+            int32_t sum;
+        } boxcar;
+        struct {
+            cic_acc_t integ[CIC_ORDER];  // wrap-around arithmetic is intended
+            cic_acc_t comb[CIC_ORDER];
+            uint8_t  warmup;             // outputs still to discard
+        } cic;
+        struct {
+            int16_t history[FIR_TAPS];
+            uint8_t head;                // next slot to write
+            bool    primed;
+        } fir;
+    };
+} decim_filter_t;
+
+void decim_filter_init(decim_filter_t *f, decim_filter_type_t type);
+
+// Feeds one sample, returns true and sets *out every DECIMATE_FACTOR inputs
+// (CIC: after its first CIC_ORDER - 1 outputs, which are settling)
+bool decim_filter_push(decim_filter_t *f, int16_t in, int16_t *out);
+
+const char *decim_filter_name(decim_filter_type_t type);
+
+#endif /* CW1_FILTER_H */
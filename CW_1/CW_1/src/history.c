@@ -0,0 +1,83 @@
+/* CW_1 minute history, see history.h */
+#include "history.h"
+
+#include <string.h>
+
+void history_init(history_t *h, uint8_t channels)
+{
+    memset(h, 0, sizeof(*h));
+    h->channels = (channels > HISTORY_MAX_CHANNELS) ? HISTORY_MAX_CHANNELS : channels;
+}
+
+static void history_open(history_t *h)
+{
+    history_block_t *b = &h->blocks[h->closed % HISTORY_BLOCKS];
+
+    b->first_minute = h->minute;
+    b->count = 0;
+    b->len = 0;
+    h->open = true;
+
+    // first record of a block is absolute
+    for (int c = 0; c < h->channels; c++) {
+        h->last[c] = HISTORY_MISSING;
+    }
+}
+
+void history_seal(history_t *h)
+{
+    if (h->open && h->blocks[h->closed % HISTORY_BLOCKS].count > 0) {
+        h->closed++;
+        h->open = false;
+    }
+}
+
+void history_add(history_t *h, const int16_t *temps_centi)
+{
+    history_block_t *b = &h->blocks[h->closed % HISTORY_BLOCKS];
+
+    // worst case every value needs the escape + i16
+    if (h->open && b->len + 3 * h->channels > HISTORY_BLOCK_DATA) {
+        history_seal(h);
+        b = &h->blocks[h->closed % HISTORY_BLOCKS];
+    }
+    if (!h->open) {
+        history_open(h);
+    }
+
+    for (int c = 0; c < h->channels; c++) {
+        int16_t v = temps_centi[c];
+        int32_t delta = (int32_t)v - h->last[c];
+
+        if (v != HISTORY_MISSING && h->last[c] != HISTORY_MISSING &&
+            delta > -128 && delta < 128) {
+            b->data[b->len++] = (uint8_t)(int8_t)delta;
+        } else {
+            b->data[b->len++] = HISTORY_ESCAPE;
+            b->data[b->len++] = (uint8_t)((uint16_t)v & 0xFF);
+            b->data[b->len++] = (uint8_t)((uint16_t)v >> 8);
+        }
+        h->last[c] = v;
+    }
+
+    b->count++;
+    h->minute++;
+}
+
+uint32_t history_oldest(const history_t *h)
+{
+    // the slot of block closed - HISTORY_BLOCKS is reused by the open block
+    return (h->closed >= HISTORY_BLOCKS) ? h->closed - (HISTORY_BLOCKS - 1) : 0;
+}
+
+size_t history_block_serialize(const history_block_t *b, uint8_t *out)
+{
+    out[0] = (uint8_t)(b->first_minute & 0xFF);
+    out[1] = (uint8_t)((b->first_minute >> 8) & 0xFF);
+    out[2] = (uint8_t)((b->first_minute >> 16) & 0xFF);
+    out[3] = (uint8_t)(b->first_minute >> 24);
+    out[4] = b->count;
+    memcpy(&out[HISTORY_BLOCK_HDR_LEN], b->data, b->len);
+
+    return HISTORY_BLOCK_HDR_LEN + b->len;
+}
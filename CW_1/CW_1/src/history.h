@@ -0,0 +1,61 @@
+/* CW_1 minute history - one record per minute holding every channel's
+ * average, delta-encoded into fixed size blocks so it can be sent in bulk
+ * and a gateway can backfill what it missed. No Zephyr dependencies.
+ *
+ * Block wire format (little-endian):
+ *   u32 first_minute   minute index of the first record
+ *   u8  count          records in the block
+ *   values...          count * channels values, channel order, each either
+ *                      an i8 delta from the same channel's previous value or
+ *                      HISTORY_ESCAPE followed by an absolute i16.
+ * The first record of a block is always absolute, so every block decodes on
+ * its own. HISTORY_MISSING (absolute) marks a minute with no valid average.
+ */
+#ifndef CW1_HISTORY_H
+#define CW1_HISTORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define HISTORY_MAX_CHANNELS 8
+#define HISTORY_BLOCK_DATA   48     // encoded bytes per block, ~45 min of one channel
+#define HISTORY_BLOCKS       32     // ring size, the open block reuses the oldest slot
+#define HISTORY_ESCAPE       0x80
+#define HISTORY_MISSING      INT16_MIN
+
+#define HISTORY_BLOCK_HDR_LEN  5
+#define HISTORY_BLOCK_WIRE_MAX (HISTORY_BLOCK_HDR_LEN + HISTORY_BLOCK_DATA)
+
+typedef struct {
+    uint32_t first_minute;
+    uint8_t  count;
+    uint8_t  len;           // bytes used in data
+    uint8_t  data[HISTORY_BLOCK_DATA];
+} history_block_t;
+
+typedef struct {
+    history_block_t blocks[HISTORY_BLOCKS];
+    uint32_t minute;        // index of the next record
+    uint32_t closed;        // blocks closed so far, block n lives in blocks[n % HISTORY_BLOCKS]
+    uint8_t  channels;
+    bool     open;          // blocks[closed % HISTORY_BLOCKS] is being filled
+    int16_t  last[HISTORY_MAX_CHANNELS];
+} history_t;
+
+void history_init(history_t *h, uint8_t channels);
+
+// Appends one minute record (channels values), opening a new block when the
+// current one is full
+void history_add(history_t *h, const int16_t *temps_centi);
+
+// Closes the open block early so it can be sent, no-op when it is empty
+void history_seal(history_t *h);
+
+// Oldest closed block still held (blocks oldest..h->closed-1 are readable)
+uint32_t history_oldest(const history_t *h);
+
+// Writes a block in wire format (HISTORY_BLOCK_WIRE_MAX bytes at most), returns the length
+size_t history_block_serialize(const history_block_t *b, uint8_t *out);
+
+#endif /* CW1_HISTORY_H */
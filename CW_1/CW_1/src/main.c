@@ -4,74 +4,119 @@
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/adc.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/uart.h>
 #include <stdbool.h>
+#include <string.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/spsc_lockfree.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/bluetooth/bluetooth.h>
 #include <stdint.h> 
+#if defined(CONFIG_SEGGER_SYSTEMVIEW)
 #include <SEGGER_SYSVIEW.h>
+#else
+#define SEGGER_SYSVIEW_PrintfHost(...)
+#endif
+#if defined(CONFIG_ADC_EMUL)
+#include <zephyr/drivers/adc/adc_emul.h>
+#endif
 
+#include "processing.h"
+#include "adv_payload.h"
+#include "history.h"
+#if defined(CW1_REPLAY)
+#include "replay.h"
+#include <nsi_main.h>
+#endif
 
-#define ABS(x) ((x) < 0 ? -(x) : (x))
-// State definitions
-typedef enum {
-    STATE_NORMAL = 0, // = if the avg temp <= threshold
-    STATE_WARNING,    // = if the1 min Average temp > threshold
-    STATE_FAULT,       // = Incorrect reading
-    STATE_DRIFT
-} system_state_t;
-
-//Sample Struct
-typedef struct {
-    int16_t raw;
-    int32_t mv;
-    int16_t temp_centi;
-    bool    valid;
-} sample_t;
-
-#define SAMPLE_PERIOD_MS 100    // Aquistion period
-#define DEFAULT_TEMP_THRESHOLD_CENTI 2800  // Temp warning thresh
-
-// Shared states
-static system_state_t system_state      = STATE_NORMAL;
-static int16_t        latest_temp_centi = 0;
-static int32_t        latest_mv         = 0; 
-static int16_t avg_temp_centi = 0;
-static int16_t warning_threshold_centi = DEFAULT_TEMP_THRESHOLD_CENTI;
-
-// Stores 1 min rolling avg
-#define DECIMATE_FACTOR    10
-#define AVG_WINDOW_SAMPLES 60
-#define DRIFT_UPDATE_SAMPLES 600  // 24 hours 
+//ADC channels - every io-channels entry of zephyr,user is one LM335, all
+//taken in a single scan sequence per sampling
+#define ADC_USER_NODE DT_PATH(zephyr_user)
+#define NUM_CHANNELS  DT_PROP_LEN(ADC_USER_NODE, io_channels)
+
+// The advert has to carry every channel's temperature next to the name even
+// when none of them can be sent as a delta, which leaves room for 5 (checked
+// again against ADV_MFG_DATA_MAX below)
+#define MAX_CHANNELS  5
+
+BUILD_ASSERT(NUM_CHANNELS >= 1 && NUM_CHANNELS <= MAX_CHANNELS,
+             "CW_1 supports 1 to 5 io-channels");
+
+// Timing and thread settings come from Kconfig (CW_1/CW_1/Kconfig), so
+// tuned variants are a .conf overlay rather than a source patch
+#define SAMPLE_PERIOD_MS  CONFIG_CW1_SAMPLE_PERIOD_MS    // Aquistion period
+#define ACQ_BATCH_SAMPLES CONFIG_CW1_ACQ_BATCH_SAMPLES   // Samples per ADC wake-up (1 = one adc_read() per tick)
+#define ACQ_BLOCK_PERIOD_MS (SAMPLE_PERIOD_MS * ACQ_BATCH_SAMPLES)
+
+BUILD_ASSERT(ACQ_BATCH_SAMPLES >= 1 && ACQ_BATCH_SAMPLES <= 255,
+             "ACQ_BATCH_SAMPLES must fit the block count");
+BUILD_ASSERT(60000 % SAMPLE_PERIOD_MS == 0,
+             "SAMPLE_PERIOD_MS must divide a minute for the history records");
+
+// Streaming acquisition - instead of one sequence per block started by
+// sample_timer, one ADC sequence over the two halves of stream_buf is kept
+// running back to back, a scan every STREAM_INTERVAL_US. Logic averages
+// STREAM_OVERSAMPLE scans into each sample, so the sample rate seen by
+// processing stays SAMPLE_PERIOD_MS.
+#ifdef CONFIG_CW1_ACQ_STREAMING
+#define ACQ_STREAMING 1
+#else
+#define ACQ_STREAMING 0
+#endif
 
-typedef struct {
-    int16_t buffer[AVG_WINDOW_SAMPLES];
-    int32_t sum_centi;
-    int32_t decimate_sum;
-    uint16_t index;
-    uint16_t valid_samples;
-    uint8_t  decimate_count;
-} temp_avg_t; 
+#if ACQ_STREAMING
+#define STREAM_INTERVAL_US  CONFIG_CW1_STREAM_INTERVAL_US
+#define STREAM_OVERSAMPLE   ((int)(SAMPLE_PERIOD_MS * USEC_PER_MSEC / STREAM_INTERVAL_US))
+#define STREAM_HALF_SCANS   (ACQ_BATCH_SAMPLES * STREAM_OVERSAMPLE)   // one block per half
+#define STREAM_FAILED_BIT   2       // stream_ready bit, set when a sequence failed
+
+BUILD_ASSERT((SAMPLE_PERIOD_MS * USEC_PER_MSEC) % STREAM_INTERVAL_US == 0,
+             "SAMPLE_PERIOD_MS must be a multiple of STREAM_INTERVAL_US");
+BUILD_ASSERT(2 * STREAM_HALF_SCANS - 1 <= UINT16_MAX,
+             "both halves must fit the 16-bit extra_samplings");
+#if defined(CW1_REPLAY)
+#error "CW1_REPLAY feeds one value per conversion, build it without CONFIG_CW1_ACQ_STREAMING"
+#endif
+#endif
 
-static temp_avg_t temp_avg = {0};
+// Event loop - instead of the acquisition, logic, reporting and BLE threads,
+// main runs their bodies as handlers of a single k_poll loop woken by the
+// sample timer, the ADC, the button and BLE. One stack instead of five and
+// no context switch between taking a block and processing it; handlers run
+// to completion, so nothing in them may block (see event_loop()).
+#ifdef CONFIG_CW1_EVENT_LOOP
+#define CW1_EVENT_LOOP 1
+#else
+#define CW1_EVENT_LOOP 0
+#endif
 
+//Block of samples taken in one ADC sequence. The ADC writes straight into
+//adc_raw of a ring slot, so the block is never copied on its way to logic.
+//adc_raw holds one scan (every channel, ascending channel id) per sampling.
+typedef struct {
+    int16_t  adc_raw[ACQ_BATCH_SAMPLES * NUM_CHANNELS];
+    sample_t samples[ACQ_BATCH_SAMPLES][NUM_CHANNELS];
+    uint8_t  count;
+    uint32_t done_cyc;          // cycle count when the ADC finished the block
+} sample_block_t;
 
-static bool drift_detected = false;
+#define SAMPLE_RING_SLOTS 4     // power of two
 
-// Welford baseline tracking
-static uint32_t drift_count = 0;
-static int32_t  drift_mean_centi = 0;
-static int64_t  drift_M2 = 0;
+BUILD_ASSERT(IS_POWER_OF_TWO(SAMPLE_RING_SLOTS), "spsc needs a power-of-two ring");
 
-// Reference baseline
-static bool     drift_ref_valid = false;
-static int32_t  drift_ref_centi = 0;
+// SAADC hardware oversampling in front of the software filter (Kconfig)
+#ifndef CONFIG_CW1_ADC_OVERSAMPLING
+#define CONFIG_CW1_ADC_OVERSAMPLING 0
+#endif
 
-static uint32_t minute_sample_counter = 0;
+BUILD_ASSERT(CONFIG_CW1_ADC_OVERSAMPLING == 0 || NUM_CHANNELS == 1,
+             "SAADC oversampling only works with a single channel");
 
-#define DRIFT_THRESHOLD_CENTI 200   // 2.00C
-#define STABLE_BAND_CENTI 400       // 4.00C
-#define DRIFT_REF_MIN_UPDATES 1440  // REFERNCE VALID AFTER 24 HRS
+// Logic-owned state, readers use state_snap
+static thermal_proc_t proc[NUM_CHANNELS];
+static system_state_t node_state = STATE_NORMAL;   // worst channel state
 
 //LED Setup
 #define LED0_NODE DT_ALIAS(led0)
@@ -80,6 +125,12 @@ static uint32_t minute_sample_counter = 0;
 #endif
 static const struct gpio_dt_spec led0 = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 
+// LED pattern engine - reprogrammed by logic only when the state changes,
+// blinking is done by led_timer so no thread wakes up for the LED
+#define LED_BLINK_HALF_PERIOD_MS 50
+static system_state_t led_state = STATE_NORMAL;
+static uint32_t led_wakeups = 0;    // led_timer expiries
+
 // Button Setup
 #define BUTTON0_NODE DT_ALIAS(sw0)
 #if !DT_NODE_HAS_STATUS(BUTTON0_NODE, okay)
@@ -89,50 +140,130 @@ static const struct gpio_dt_spec button0 = GPIO_DT_SPEC_GET(BUTTON0_NODE, gpios)
 static struct gpio_callback button_cb_data;
 
 //ADC Setup
-static const struct adc_dt_spec adc_channel =
-    ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+#define ADC_SPEC_AND_COMMA(node_id, prop, idx) ADC_DT_SPEC_GET_BY_IDX(node_id, idx),
+
+static const struct adc_dt_spec adc_channels[] = {
+    DT_FOREACH_PROP_ELEM(ADC_USER_NODE, io_channels, ADC_SPEC_AND_COMMA)
+};
+
+static uint32_t adc_channel_mask;               // sequence channels bitmask
+static uint8_t  adc_scan_pos[NUM_CHANNELS];     // index of each channel within a scan
 
-static int16_t adc_buf;     // raw adc buff
 static bool adc_setup_done; 
 static volatile bool calibration_requested = false;
 static int64_t last_button_press_ms = 0;
+#if CW1_EVENT_LOOP
+static struct k_poll_signal button_sig = K_POLL_SIGNAL_INITIALIZER(button_sig);
+#endif
+
+// State published by logic for the LED, BLE and reporting threads. Logic is
+// the only writer; readers copy it under a sequence counter and retry if a
+// publish overlapped the copy, so nobody blocks on the logic thread.
+typedef struct {
+    system_state_t state;
+    int16_t avg_temp_centi;
+    int16_t latest_temp_centi;
+    int32_t latest_mv;
+    int32_t drift_mean_centi;
+    int32_t drift_ref_centi;
+    bool    drift_ref_valid;
+    bool    drift_detected;
+} channel_snapshot_t;
 
-K_MUTEX_DEFINE(state_mutex);
-K_MSGQ_DEFINE(sample_msgq, sizeof(sample_t), 10, 4);
+typedef struct {
+    system_state_t     state;           // worst channel state
+    int16_t            threshold_centi;
+    channel_snapshot_t ch[NUM_CHANNELS];
+} state_snapshot_t;
+
+static state_snapshot_t state_snap;
+static atomic_t state_seq = ATOMIC_INIT(0);   // odd while a publish is in progress
+
+K_SEM_DEFINE(sample_ring_sem, 0, SAMPLE_RING_SLOTS);   // blocks (or stream halves) for logic
+
+#if ACQ_STREAMING
+// Written by the ADC (EasyDMA) scan after scan, both halves in one sequence.
+// A half is handed to logic when its last scan is in and given back as soon
+// as logic has averaged it, while the ADC fills the other half.
+static int16_t stream_buf[2][STREAM_HALF_SCANS * NUM_CHANNELS];
+static atomic_t stream_ready = ATOMIC_INIT(0);    // bit n: half n full, not yet averaged
+static struct k_poll_signal stream_done_sig;      // sequence over both halves completed
+static sample_t stream_samples[ACQ_BATCH_SAMPLES][NUM_CHANNELS];   // logic thread only
+static int stream_next_half;                      // logic thread only
+static uint32_t stream_done_cyc[2];               // cycle count when each half filled
+#elif CW1_EVENT_LOOP
+// The loop has at most one block in flight, so it needs no ring
+static sample_block_t loop_block;
+static struct k_poll_signal adc_done_sig = K_POLL_SIGNAL_INITIALIZER(adc_done_sig);
+static bool adc_busy;                             // loop_block sequence running
+K_SEM_DEFINE(sample_sem, 0, 1);
+static struct k_timer sample_timer;
+#else
+// Single-producer (acquisition) / single-consumer (logic) ring of block slots
+SPSC_DEFINE(sample_ring, sample_block_t, SAMPLE_RING_SLOTS);
 K_SEM_DEFINE(sample_sem, 0, 1);
 static struct k_timer sample_timer;
+#endif
+
+// Wake-up counters (acquisition thread runs once per block)
+static uint32_t acq_wakeups   = 0;
+static uint32_t acq_samples   = 0;
+static uint32_t logic_wakeups = 0;
+static atomic_t ring_overruns = ATOMIC_INIT(0);   // blocks not taken because every slot was owned by logic
+                                                  // (streaming: halves overwritten before logic averaged
+                                                  // them, counted in the ADC ISR; event loop: ticks while
+                                                  // the previous block was running)
+static atomic_t block_latency_us = ATOMIC_INIT(0);   // worst ADC completion -> block processed since the last report
+
+#if defined(CONFIG_ADC_EMUL)
+#define EMUL_SENSOR_MV 2982     // ~25C on an LM335 (10mV/K)
+#endif
 
 // BLE Setup
 #define DEVICE_NAME "QASIM"
 #define DEVICE_NAME_LEN (sizeof(DEVICE_NAME) - 1)
 #define COMPANY_ID 0x0059
 #define GROUP_ID   0x01
-#define BLE_UPDATE_PERIOD_MS 1000
+#define BLE_UPDATE_PERIOD_MS CONFIG_CW1_BLE_UPDATE_PERIOD_MS
 #define BT_ADV_INTERVAL 0x00A0   
 
-//BLE data Structs
-struct adv_mfg_data {
-    uint16_t company_id;
-    uint8_t  group_id;
-    int16_t  avg_temp_x100;
-    uint8_t  state;
-} __packed;
+// Change-triggered advertising: payload only rebuilt on a state change or a
+// move of BLE_DEADBAND_CENTI, interval doubles while stable
+#ifdef CONFIG_CW1_BLE_ADAPTIVE_ADV
+#define BLE_ADAPTIVE_ADV 1
+#else
+#define BLE_ADAPTIVE_ADV 0      // rebuild payload every BLE_UPDATE_PERIOD_MS
+#endif
 
-static struct adv_mfg_data adv_mfg_data = {
-    .company_id = COMPANY_ID,
-    .group_id = GROUP_ID,
-    .avg_temp_x100 = 0,
-    .state = STATE_NORMAL,
-};
+#if BLE_ADAPTIVE_ADV
+#define BLE_DEADBAND_CENTI    CONFIG_CW1_BLE_DEADBAND_CENTI
+#define BLE_STABLE_PERIOD_MS  CONFIG_CW1_BLE_STABLE_PERIOD_MS   // no change for this long -> back off
+#define BT_ADV_INTERVAL_MIN   BT_ADV_INTERVAL   // 100 ms
+#define BT_ADV_INTERVAL_MAX   (CONFIG_CW1_BLE_ADV_INTERVAL_MAX_MS * 8 / 5)   // 0.625 ms units
+
+BUILD_ASSERT(BT_ADV_INTERVAL_MAX >= BT_ADV_INTERVAL_MIN && BT_ADV_INTERVAL_MAX <= 0x4000,
+             "CW1_BLE_ADV_INTERVAL_MAX_MS must be 100 ms to 10.24 s");
+#endif
+
+//BLE data - versioned payload (common/adv_payload): one temperature per
+//channel, delta-encoded where it fits, then the packed channel states.
+//Whatever the legacy PDU has left after the name goes to manufacturer data.
+//The budget is the worst case, every temperature absolute (3 bytes): the
+//deltas only fit while neighbouring channels are within 1.27C.
+#define ADV_MFG_DATA_MAX (31 - (2 + DEVICE_NAME_LEN) - 2)
 
-static const struct bt_data ad[] = {
+BUILD_ASSERT(ADV_PAYLOAD_HDR_LEN + MAX_CHANNELS * ADV_FIELD_TEMP_LEN +
+             ADV_FIELD_STATES_LEN(MAX_CHANNELS) <= ADV_MFG_DATA_MAX,
+             "MAX_CHANNELS temperatures do not fit a legacy advertising PDU");
+
+static uint8_t adv_mfg_data[ADV_MFG_DATA_MAX];
+
+static struct bt_data ad[] = {
     BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
-    BT_DATA(BT_DATA_MANUFACTURER_DATA,
-            (uint8_t *)&adv_mfg_data,
-            sizeof(adv_mfg_data)),
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, adv_mfg_data, 0),    // length set by ble_fill_payload()
 };
 
-static const struct bt_le_adv_param *adv_param = BT_LE_ADV_PARAM(
+static struct bt_le_adv_param adv_param = BT_LE_ADV_PARAM_INIT(
     BT_LE_ADV_OPT_NONE,
     BT_ADV_INTERVAL,
     BT_ADV_INTERVAL,
@@ -140,9 +271,305 @@ static const struct bt_le_adv_param *adv_param = BT_LE_ADV_PARAM(
 );
 
 static bool ble_started = false;
+static uint32_t ble_updates = 0;    // payload rebuilds
+
+#if BLE_ADAPTIVE_ADV
+K_SEM_DEFINE(ble_update_sem, 0, 1);
+
+// Last values signalled to the BLE thread (logic thread only)
+static bool           ble_signalled = false;
+static system_state_t ble_signalled_state[NUM_CHANNELS];
+static int16_t        ble_signalled_avg[NUM_CHANNELS];
+#endif
+
+// Minute history - logic appends one record per minute, the BLE thread sends
+// the closed blocks in bursts over extended advertising (history.h)
+#define HISTORY_PERIOD_SAMPLES  (60000 / SAMPLE_PERIOD_MS)
+#define HISTORY_SEAL_BIT        0
+
+BUILD_ASSERT(NUM_CHANNELS <= HISTORY_MAX_CHANNELS, "too many channels for the history");
+
+static history_t history;                        // logic thread only
+static uint32_t  history_samples;                // samples since the last record
+static atomic_t  history_closed = ATOMIC_INIT(0);   // published history.closed
+static atomic_t  history_minute = ATOMIC_INIT(0);   // published history.minute
+static atomic_t  history_flags  = ATOMIC_INIT(0);
+K_SEM_DEFINE(history_sealed_sem, 0, 1);
+
+#if defined(CONFIG_BT_EXT_ADV)
+#define HISTORY_BURST_PERIOD_MS  (15 * 60 * 1000)
+#define HISTORY_BURST_EVENTS     3      // times each chunk is advertised
+#define HISTORY_BLOCKS_PER_ADV   4
+#define HISTORY_ADV_INTERVAL     0x00A0 // 100 ms between the events of a chunk
+
+#define HISTORY_ADV_DATA_MAX (ADV_PAYLOAD_HDR_LEN + 2 + sizeof(uint32_t) + \
+                              HISTORY_BLOCKS_PER_ADV * (2 + HISTORY_BLOCK_WIRE_MAX))
+
+BUILD_ASSERT((2 + DEVICE_NAME_LEN) + (2 + HISTORY_ADV_DATA_MAX) <= 251,
+             "history chunk does not fit one extended PDU");
+
+static struct bt_le_ext_adv *history_adv;
+static uint8_t history_adv_data[HISTORY_ADV_DATA_MAX];
+static struct bt_data history_ad[] = {
+    BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, history_adv_data, 0),
+};
+static int64_t  history_next_burst_ms = HISTORY_BURST_PERIOD_MS;
+static uint32_t history_bursts = 0;
+K_SEM_DEFINE(history_sent_sem, 0, 1);
+
+static void history_adv_sent(struct bt_le_ext_adv *adv, struct bt_le_ext_adv_sent_info *info)
+{
+    ARG_UNUSED(adv);
+    ARG_UNUSED(info);
+    k_sem_give(&history_sent_sem);
+}
+
+static const struct bt_le_ext_adv_cb history_adv_cb = {
+    .sent = history_adv_sent,
+};
+
+// Non-connectable, non-scannable extended advertising set, idle until a burst.
+// Identity address, so the gateway sees the same device on every burst.
+static int history_adv_init(void)
+{
+    const struct bt_le_adv_param *param = BT_LE_ADV_PARAM(
+        BT_LE_ADV_OPT_EXT_ADV | BT_LE_ADV_OPT_USE_IDENTITY,
+        HISTORY_ADV_INTERVAL,
+        HISTORY_ADV_INTERVAL,
+        NULL
+    );
+
+    return bt_le_ext_adv_create(param, &history_adv_cb, &history_adv);
+}
+
+// Copies closed block seq, false if logic may have reused its slot meanwhile
+static bool history_block_copy(uint32_t seq, history_block_t *out)
+{
+    memcpy(out, &history.blocks[seq % HISTORY_BLOCKS], sizeof(*out));
+    barrier_dmem_fence_full();
+
+    uint32_t closed = (uint32_t)atomic_get(&history_closed);
+
+    // one block more than history_oldest(): logic may already be refilling that slot
+    return closed < HISTORY_BLOCKS - 1 || seq > closed - (HISTORY_BLOCKS - 1);
+}
+
+#define HISTORY_SEND_TIMEOUT_MS  (HISTORY_BURST_EVENTS * 200 + 500)
+
+// Starts advertising one chunk, history_sent_sem is given once it is sent
+static int history_adv_start(size_t len)
+{
+    int err;
+
+    history_ad[1].data_len = (uint8_t)len;
+
+    err = bt_le_ext_adv_set_data(history_adv, history_ad, ARRAY_SIZE(history_ad), NULL, 0);
+    if (err) {
+        return err;
+    }
+
+    k_sem_reset(&history_sent_sem);
+    return bt_le_ext_adv_start(history_adv, BT_LE_EXT_ADV_START_PARAM(0, HISTORY_BURST_EVENTS));
+}
+
+// Oldest block a burst sends, the one before it may already be refilled
+static uint32_t history_burst_first(uint32_t closed)
+{
+    return (closed >= HISTORY_BLOCKS - 1) ? closed - (HISTORY_BLOCKS - 2) : 0;
+}
+
+// Encodes up to HISTORY_BLOCKS_PER_ADV blocks from *seq into history_adv_data
+// and moves *seq past them. Each chunk carries the current minute so the
+// gateway can timestamp the records without a clock on the device.
+static int history_chunk_encode(uint32_t *seq, uint32_t closed, uint32_t *sent)
+{
+    adv_payload_t payload;
+    uint8_t minute[sizeof(uint32_t)];
+    int len;
+
+    adv_payload_init(&payload, history_adv_data, sizeof(history_adv_data), COMPANY_ID, GROUP_ID);
+    sys_put_le32((uint32_t)atomic_get(&history_minute), minute);
+    adv_payload_put_ext(&payload, ADV_FIELD_MINUTE, 0, minute, sizeof(minute));
+
+    for (int k = 0; k < HISTORY_BLOCKS_PER_ADV && *seq < closed; k++, (*seq)++) {
+        history_block_t blk;
+        uint8_t wire[HISTORY_BLOCK_WIRE_MAX];
+
+        if (!history_block_copy(*seq, &blk)) {
+            continue;
+        }
+        adv_payload_put_ext(&payload, ADV_FIELD_HISTORY, NUM_CHANNELS, wire,
+                            (uint8_t)history_block_serialize(&blk, wire));
+        (*sent)++;
+    }
+
+    len = adv_payload_finish(&payload);
+    if (len < 0) {
+        printk("History encode failed (err=%d)\n", len);
+    }
+    return len;
+}
+
+#if CW1_EVENT_LOOP
+// Burst in progress. The loop cannot wait for a chunk to go out, so each
+// chunk is started here and the next one when history_sent_sem is given.
+static struct {
+    bool     active;
+    uint32_t seq;
+    uint32_t closed;
+    uint32_t sent;
+    int64_t  deadline_ms;       // chunk in flight gives up at this uptime
+} history_tx;
+
+// Starts the next chunk of the burst, or ends the burst when none is left
+static void history_burst_step(void)
+{
+    int len;
+    int err;
+
+    if (!history_tx.active) {
+        return;
+    }
+
+    if (history_tx.seq >= history_tx.closed) {
+        history_tx.active = false;
+        history_bursts++;
+        printk("History burst: %u blocks\n", history_tx.sent);
+        return;
+    }
+
+    len = history_chunk_encode(&history_tx.seq, history_tx.closed, &history_tx.sent);
+    if (len < 0) {
+        history_tx.active = false;
+        return;
+    }
+
+    err = history_adv_start((size_t)len);
+    if (err) {
+        printk("History burst failed (err=%d)\n", err);
+        history_tx.active = false;
+        return;
+    }
+    history_tx.deadline_ms = k_uptime_get() + HISTORY_SEND_TIMEOUT_MS;
+}
+
+// Gives up on a chunk the controller did not report as sent in time
+static void history_burst_timeout(void)
+{
+    if (history_tx.active && k_uptime_get() >= history_tx.deadline_ms) {
+        bt_le_ext_adv_stop(history_adv);
+        printk("History burst failed (err=%d)\n", -ETIMEDOUT);
+        history_tx.active = false;
+    }
+}
 
-//Utility Functions
-static const char *state_to_string(system_state_t state)  
+// Called from the event loop, starts a burst every HISTORY_BURST_PERIOD_MS.
+// Logic runs on the same thread, so the open block is sealed right here.
+static void history_burst_poll(void)
+{
+    if (history_adv == NULL || history_tx.active || k_uptime_get() < history_next_burst_ms) {
+        return;
+    }
+
+    history_seal(&history);
+    atomic_set(&history_closed, history.closed);
+
+    history_tx.active = true;
+    history_tx.closed = history.closed;
+    history_tx.seq    = history_burst_first(history.closed);
+    history_tx.sent   = 0;
+    history_next_burst_ms = k_uptime_get() + HISTORY_BURST_PERIOD_MS;
+
+    history_burst_step();
+}
+#else
+// Advertises one chunk and waits until the controller has sent it
+static int history_adv_send(size_t len)
+{
+    int err = history_adv_start(len);
+
+    if (err) {
+        return err;
+    }
+
+    if (k_sem_take(&history_sent_sem, K_MSEC(HISTORY_SEND_TIMEOUT_MS)) != 0) {
+        bt_le_ext_adv_stop(history_adv);
+        return -ETIMEDOUT;
+    }
+    return 0;
+}
+
+// Sends every held history block, HISTORY_BLOCKS_PER_ADV per extended advert
+static void history_burst(void)
+{
+    // close the open block so the burst reaches the current minute
+    k_sem_reset(&history_sealed_sem);
+    atomic_set_bit(&history_flags, HISTORY_SEAL_BIT);
+    (void)k_sem_take(&history_sealed_sem, K_MSEC(2 * ACQ_BLOCK_PERIOD_MS));
+
+    uint32_t closed = (uint32_t)atomic_get(&history_closed);
+    uint32_t seq = history_burst_first(closed);
+    uint32_t sent = 0;
+
+    while (seq < closed) {
+        int len = history_chunk_encode(&seq, closed, &sent);
+        if (len < 0) {
+            return;
+        }
+
+        int err = history_adv_send((size_t)len);
+        if (err) {
+            printk("History burst failed (err=%d)\n", err);
+            return;
+        }
+    }
+
+    history_bursts++;
+    printk("History burst: %u blocks\n", sent);
+}
+
+// Called from the BLE thread loop, runs a burst every HISTORY_BURST_PERIOD_MS
+static void history_burst_poll(void)
+{
+    if (history_adv == NULL || k_uptime_get() < history_next_burst_ms) {
+        return;
+    }
+    history_burst();
+    history_next_burst_ms = k_uptime_get() + HISTORY_BURST_PERIOD_MS;
+}
+#endif
+#else
+static void history_burst_poll(void)
+{
+}
+#endif
+
+// Logic thread: one record per minute, closes the open block on request
+static void history_update(void)
+{
+    if (++history_samples >= HISTORY_PERIOD_SAMPLES) {
+        int16_t temps[NUM_CHANNELS];
+
+        history_samples = 0;
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            temps[c] = (proc[c].system_state == STATE_FAULT) ? HISTORY_MISSING
+                                                             : proc[c].avg_temp_centi;
+        }
+        history_add(&history, temps);
+        atomic_set(&history_minute, history.minute);
+        atomic_set(&history_closed, history.closed);
+    }
+
+    if (atomic_test_and_clear_bit(&history_flags, HISTORY_SEAL_BIT)) {
+        history_seal(&history);
+        atomic_set(&history_closed, history.closed);
+        k_sem_give(&history_sealed_sem);
+    }
+}
+
+//Utility Functions - unused on the device when the status report is binary
+static __maybe_unused const char *state_to_string(system_state_t state)  
 {
     switch (state) {
     case STATE_NORMAL:  return "NORMAL";
@@ -153,7 +580,7 @@ static const char *state_to_string(system_state_t state)
     }
 }
 
-static const char *led_to_string(system_state_t state) 
+static __maybe_unused const char *led_to_string(system_state_t state) 
 {
     switch (state) {
     case STATE_NORMAL:  return "OFF";
@@ -164,11 +591,137 @@ static const char *led_to_string(system_state_t state)
     }
 }
 
+static void led_timer_handler(struct k_timer *timer_id)
+{
+    ARG_UNUSED(timer_id);
+    led_wakeups++;
+    gpio_pin_toggle_dt(&led0);
+}
+
+K_TIMER_DEFINE(led_timer, led_timer_handler, NULL);
+
+// Sets LED mode for a state (off, blinking, solid)
+static void led_pattern_set(system_state_t state)
+{
+    k_timer_stop(&led_timer);
+
+    switch (state) {
+    case STATE_WARNING:
+    case STATE_DRIFT:
+        gpio_pin_set_dt(&led0, 1);
+        k_timer_start(&led_timer, K_MSEC(LED_BLINK_HALF_PERIOD_MS),
+                      K_MSEC(LED_BLINK_HALF_PERIOD_MS));
+        break;
+    case STATE_FAULT:
+        gpio_pin_set_dt(&led0, 1);
+        break;
+    case STATE_NORMAL:
+    default:
+        gpio_pin_set_dt(&led0, 0);
+        break;
+    }
+}
+
+// Called by logic after each publish, only touches the LED on a transition
+static void led_update(system_state_t state)
+{
+    if (state != led_state) {
+        led_state = state;
+        led_pattern_set(state);
+    }
+}
+
+// Fills the advert from a snapshot, FAULT channels keep their last good average
+static void ble_fill_payload(const state_snapshot_t *snap)
+{
+    adv_payload_t payload;
+    uint8_t states[NUM_CHANNELS];
+    int len;
+
+    adv_payload_init(&payload, adv_mfg_data, sizeof(adv_mfg_data), COMPANY_ID, GROUP_ID);
+
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        adv_payload_put_temp(&payload, c, snap->ch[c].avg_temp_centi);
+        states[c] = (uint8_t)snap->ch[c].state;
+    }
+    adv_payload_put_states(&payload, states, NUM_CHANNELS);
+
+    len = adv_payload_finish(&payload);
+    if (len < 0) {
+        printk("BLE payload encode failed (err=%d)\n", len);
+        return;
+    }
+    ad[1].data_len = (uint8_t)len;
+}
+
+#if BLE_ADAPTIVE_ADV
+// Called by logic after each publish, wakes BLE only on a meaningful change
+static void ble_notify(void)
+{
+    bool changed = !ble_signalled;
+
+    for (int c = 0; c < NUM_CHANNELS && !changed; c++) {
+        changed = (proc[c].system_state != ble_signalled_state[c]) ||
+                  (ABS(proc[c].avg_temp_centi - ble_signalled_avg[c]) >= BLE_DEADBAND_CENTI);
+    }
+
+    if (!changed) {
+        return;
+    }
+
+    ble_signalled = true;
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        ble_signalled_state[c] = proc[c].system_state;
+        ble_signalled_avg[c]   = proc[c].avg_temp_centi;
+    }
+    k_sem_give(&ble_update_sem);
+
+#if defined(CW1_REPLAY)
+    printk("[%lld ms] BLE payload:", k_uptime_get());
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        printk(" CH%d %d.%02dC %s", c, proc[c].avg_temp_centi / 100,
+               ABS(proc[c].avg_temp_centi % 100), state_to_string(proc[c].system_state));
+    }
+    printk("\n");
+#endif
+}
+
+// Legacy advertising has to be restarted to change the interval
+static int ble_set_interval(uint16_t interval)
+{
+    int err;
+
+    err = bt_le_adv_stop();
+    if (err) {
+        return err;
+    }
+
+    adv_param.interval_min = interval;
+    adv_param.interval_max = interval;
+
+    return bt_le_adv_start(&adv_param, ad, ARRAY_SIZE(ad), NULL, 0);
+}
+#endif
+
+// Wake-ups per minute the old polling led_thread spent in each state
+static uint32_t led_polling_wakeups_per_min(system_state_t state)
+{
+    switch (state) {
+    case STATE_NORMAL:  return 60000 / 100;         // 100ms poll
+    case STATE_WARNING:
+    case STATE_DRIFT:   return 60000 / 50;          // 50ms on/off
+    case STATE_FAULT:   return 60000 / 200;         // 200ms poll
+    default:            return 60000 / 100;
+    }
+}
+
+#if !ACQ_STREAMING
 static void sample_timer_handler(struct k_timer *timer_id)
 {
     ARG_UNUSED(timer_id);
     k_sem_give(&sample_sem);
 }
+#endif
 
 static void button_pressed(const struct device *dev,
                            struct gpio_callback *cb,
@@ -186,219 +739,532 @@ static void button_pressed(const struct device *dev,
 
     last_button_press_ms = now;
     calibration_requested = true;
+#if CW1_EVENT_LOOP
+    k_poll_signal_raise(&button_sig, 0);
+#endif
 }
 
-static bool environment_is_stable(int16_t avg_centi, int16_t latest_centi)
+// Snapshot Functions
+static void state_publish(void)     // logic thread only
 {
-    return ABS(latest_centi - avg_centi) <= STABLE_BAND_CENTI;
+    atomic_inc(&state_seq);
+    barrier_dmem_fence_full();
+
+    state_snap.state           = node_state;
+    state_snap.threshold_centi = proc[0].warning_threshold_centi;
+
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        channel_snapshot_t *ch = &state_snap.ch[c];
+
+        ch->state             = proc[c].system_state;
+        ch->avg_temp_centi    = proc[c].avg_temp_centi;
+        ch->latest_temp_centi = proc[c].latest_temp_centi;
+        ch->latest_mv         = proc[c].latest_mv;
+        ch->drift_mean_centi  = proc[c].drift_mean_centi;
+        ch->drift_ref_centi   = proc[c].drift_ref_centi;
+        ch->drift_ref_valid   = proc[c].drift_ref_valid;
+        ch->drift_detected    = proc[c].drift_detected;
+    }
+
+    barrier_dmem_fence_full();
+    atomic_inc(&state_seq);
 }
 
-static void update_drift_welford(int16_t stable_avg_centi)
+static void state_read(state_snapshot_t *out)
 {
-    drift_count++;
+    atomic_val_t seq;
 
-    if (drift_count == 1) {
-        drift_mean_centi = stable_avg_centi;
-        drift_M2 = 0;
-    } else {
-        int32_t delta = stable_avg_centi - drift_mean_centi;
-        drift_mean_centi += delta / (int32_t)drift_count;
+    do {
+        seq = atomic_get(&state_seq);
+        if (seq & 1) {
+            continue;
+        }
+        *out = state_snap;
+        barrier_dmem_fence_full();
+    } while ((seq & 1) || atomic_get(&state_seq) != seq);
+}
+
+//Aquisition Functions
+static int adc_prepare(void)
+{
+    int err;
+
+    //Check ADC Ready - every channel must sit on the same ADC for one scan
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        if (!adc_is_ready_dt(&adc_channels[c])) {
+            printk("ADC %s is not ready\n", adc_channels[c].dev->name);
+            return -EIO;
+        }
+        if (adc_channels[c].dev != adc_channels[0].dev) {
+            printk("io-channels must all use one ADC\n");
+            return -EINVAL;
+        }
+    }
+
+    if (!adc_setup_done) {              //ADC Setup
+        adc_channel_mask = 0;
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            err = adc_channel_setup_dt(&adc_channels[c]);
+            if (err < 0) {
+                printk("ADC channel %d setup failed (err=%d)\n", adc_channels[c].channel_id, err);
+                return err;
+            }
+            adc_channel_mask |= BIT(adc_channels[c].channel_id);
+        }
+
+        // the driver stores each scan in ascending channel id order
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            adc_scan_pos[c] = 0;
+            for (int o = 0; o < NUM_CHANNELS; o++) {
+                if (adc_channels[o].channel_id < adc_channels[c].channel_id) {
+                    adc_scan_pos[c]++;
+                }
+            }
+        }
+
+#if defined(CW1_REPLAY)
+        err = replay_attach(adc_channels[0].dev, adc_channels[0].channel_id);
+        if (err < 0) {
+            printk("Replay attach failed (err=%d)\n", err);
+            return err;
+        }
+        for (int c = 1; c < NUM_CHANNELS; c++) {
+            adc_emul_const_value_set(adc_channels[c].dev, adc_channels[c].channel_id, EMUL_SENSOR_MV);
+        }
+#elif defined(CONFIG_ADC_EMUL)
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            adc_emul_const_value_set(adc_channels[c].dev, adc_channels[c].channel_id, EMUL_SENSOR_MV);
+        }
+#endif
+        adc_setup_done = true;
+    }
+
+    return 0;
+}
+
+// Converts one raw reading into a sample
+static int convert_sample(const struct adc_dt_spec *spec, int16_t raw, sample_t *s)
+{
+    int err;
+
+    int32_t mv = raw;
+
+    s->raw = raw;  //Stores results
+    s->mv = 0;
+    s->temp_centi = 0;
+    s->valid = false;
+
+    err = adc_raw_to_millivolts_dt(spec, &mv);   //Converts from raw to mv
+    if (err < 0) {
+        printk("mV conversion failed\n");
+        return err;
+    }
+
+    return sample_set_mv(s, mv);
+}
+
+#if ACQ_STREAMING
+// Called by the ADC driver after every scan (interrupt context)
+static enum adc_action stream_scan_done(const struct device *dev,
+                                        const struct adc_sequence *sequence,
+                                        uint16_t sampling_index)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(sequence);
+
+    int half = sampling_index / STREAM_HALF_SCANS;
+    uint16_t scan = sampling_index % STREAM_HALF_SCANS;
+
+    // first scan of a half that logic has not averaged yet
+    if (scan == 0 && atomic_test_bit(&stream_ready, half)) {
+        atomic_inc(&ring_overruns);
+    }
+    if (scan == STREAM_HALF_SCANS - 1) {
+        stream_done_cyc[half] = k_cycle_get_32();
+        atomic_set_bit(&stream_ready, half);
+        k_sem_give(&sample_ring_sem);
+    }
+
+    return ADC_ACTION_CONTINUE;
+}
+
+// Averages STREAM_OVERSAMPLE scans into each sample of one half (logic thread only)
+static void stream_decimate(const int16_t *half, sample_t (*out)[NUM_CHANNELS])
+{
+    for (int i = 0; i < ACQ_BATCH_SAMPLES; i++) {
+        const int16_t *scan = &half[i * STREAM_OVERSAMPLE * NUM_CHANNELS];
+
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            int32_t sum = 0;
+
+            for (int k = 0; k < STREAM_OVERSAMPLE; k++) {
+                sum += scan[k * NUM_CHANNELS + adc_scan_pos[c]];
+            }
+            sum += (sum >= 0) ? STREAM_OVERSAMPLE / 2 : -(STREAM_OVERSAMPLE / 2);
+            (void)convert_sample(&adc_channels[c], (int16_t)(sum / STREAM_OVERSAMPLE), &out[i][c]);
+        }
+    }
+}
+#else
+static uint32_t block_done_cyc;     // stamped by block_scan_done()
+
+// Called by the ADC driver after every scan (interrupt context). The stamp of
+// the last one is when the block was complete, before any thread woke for it.
+static enum adc_action block_scan_done(const struct device *dev,
+                                       const struct adc_sequence *sequence,
+                                       uint16_t sampling_index)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(sequence);
+
+    if (sampling_index == ACQ_BATCH_SAMPLES - 1) {
+        block_done_cyc = k_cycle_get_32();
+    }
+    return ADC_ACTION_CONTINUE;
+}
+
+// Sets up one sequence of ACQ_BATCH_SAMPLES scans of every channel into
+// blk->adc_raw. The ADC driver times the extra samplings itself, so the
+// block costs one wake-up whatever the channel count.
+static int block_sequence_init(sample_block_t *blk, struct adc_sequence *sequence)
+{
+    static const struct adc_sequence_options options = {
+        .interval_us     = SAMPLE_PERIOD_MS * USEC_PER_MSEC,
+        .callback        = block_scan_done,
+        .extra_samplings = ACQ_BATCH_SAMPLES - 1,
+    };
+    int err;
+
+    //Init samples
+    memset(blk->samples, 0, sizeof(blk->samples));
+    blk->count = ACQ_BATCH_SAMPLES;
+
+    err = adc_prepare();
+    if (err < 0) {
+        return err;
+    }
+
+    *sequence = (struct adc_sequence) {    //Read config
+        .options = &options,
+        .buffer = blk->adc_raw,
+        .buffer_size = sizeof(blk->adc_raw),
+    };
+
+    err = adc_sequence_init_dt(&adc_channels[0], sequence);
+    if (err < 0) {
+        printk("ADC sequence init failed (err=%d)\n", err);
+        return err;
+    }
+    sequence->channels = adc_channel_mask;
+    if (CONFIG_CW1_ADC_OVERSAMPLING > 0) {
+        sequence->oversampling = CONFIG_CW1_ADC_OVERSAMPLING;
+    }
+
+    return 0;
+}
+
+// Converts a completed block, or marks it invalid (FAULT) when err < 0
+static void block_convert(sample_block_t *blk, int err)
+{
+    blk->done_cyc = (err < 0) ? k_cycle_get_32() : block_done_cyc;
+
+    for (uint8_t i = 0; i < blk->count; i++) {
+        const int16_t *scan = &blk->adc_raw[i * NUM_CHANNELS];
+
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            if (err < 0) {
+                blk->samples[i][c].valid = false;
+            } else {
+                (void)convert_sample(&adc_channels[c], scan[adc_scan_pos[c]], &blk->samples[i][c]);
+            }
+        }
+    }
+}
+
+#if !CW1_EVENT_LOOP
+// Takes one block, blocking the calling thread while the ADC runs
+static int acquire_block(sample_block_t *blk)
+{
+    struct adc_sequence sequence;
+    int err;
+
+    if (blk == NULL) {
+        return -EINVAL;
+    }
+
+    err = block_sequence_init(blk, &sequence);
+    if (err == 0) {
+        err = adc_read(adc_channels[0].dev, &sequence);
+        if (err < 0) {
+            printk("ADC read failed (err=%d)\n", err);
+        }
+    }
+
+    block_convert(blk, err);
+    return err;
+}
+#endif
+#endif
+
+// Button calibration - cycles the warning threshold of every channel (logic thread only)
+static void apply_calibration(void)
+{
+    int16_t thresh = thermal_next_threshold(proc[0].warning_threshold_centi);
+
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        proc[c].warning_threshold_centi = thresh;
+    }
+
+    calibration_requested = false;
+
+    printk("Calibration: threshold set to %d.%02dC\n",
+           thresh / 100, ABS(thresh % 100));
+}
+
+// Binary status record - written raw to the console UART and formatted on
+// the host by tools/status_decoder.py. Little-endian, framed by two sync
+// bytes and closed with a CRC-8 over version..last field. A fixed header is
+// followed by one entry per channel.
+#ifndef STATUS_REPORT_BINARY
+#define STATUS_REPORT_BINARY  1     // 0 = formatted printk line
+#endif
+#ifndef REPORT_PERIOD_MS
+#define REPORT_PERIOD_MS      CONFIG_CW1_REPORT_PERIOD_MS
+#endif
+
+#define STATUS_RECORD_SYNC0   0xA5
+#define STATUS_RECORD_SYNC1   0x5A
+#define STATUS_RECORD_VERSION 3
+
+#define STATUS_FLAG_DRIFT      BIT(0)
+#define STATUS_FLAG_DRIFT_REF  BIT(1)
+
+struct status_channel {
+    uint8_t  state;
+    uint8_t  flags;
+    int16_t  avg_centi;
+    int16_t  latest_centi;
+    int32_t  mv;
+    int32_t  drift_mean_centi;
+    int32_t  drift_ref_centi;
+} __packed;
+
+struct status_record {
+    uint8_t  sync[2];
+    uint8_t  version;
+    uint8_t  len;               // bytes from uptime_ms up to crc
+    uint32_t uptime_ms;
+    uint8_t  state;             // worst channel state
+    uint8_t  num_channels;
+    int16_t  thresh_centi;
+    uint32_t acq_wakeups;
+    uint32_t logic_wakeups;
+    uint32_t acq_samples;
+    uint32_t overruns;
+    uint16_t led_rate;
+    uint16_t led_polling_rate;
+    uint16_t adv_interval_ms;
+    uint32_t ble_updates;
+    uint32_t latency_us;        // worst block latency since the last record
+    struct status_channel ch[NUM_CHANNELS];
+    uint8_t  crc;
+} __packed;
 
-        int32_t delta2 = stable_avg_centi - drift_mean_centi;
-        drift_M2 += (int64_t)delta * (int64_t)delta2;
-    }
+BUILD_ASSERT(sizeof(struct status_record) - offsetof(struct status_record, uptime_ms) - 1 <= UINT8_MAX,
+             "status record too long for its length byte");
 
-    if (!drift_ref_valid && drift_count >= DRIFT_REF_MIN_UPDATES) {
-        drift_ref_centi = drift_mean_centi;
-        drift_ref_valid = true;
-    }
+#if STATUS_REPORT_BINARY
+static const struct device *const report_uart = DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
 
-    if (drift_ref_valid &&
-        ABS(drift_mean_centi - drift_ref_centi) > DRIFT_THRESHOLD_CENTI) {
-        drift_detected = true;
+// CRC-8, poly 0x07 (same as the decoder)
+static uint8_t status_crc8(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0;
 
-        if (drift_mean_centi > drift_ref_centi) {
-            drift_ref_centi -= 200;
-        } else {
-            drift_ref_centi += 200;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
         }
-    } else {
-        drift_detected = false;
     }
+    return crc;
 }
 
-//Aquisition Function
-static int acquire_sample(sample_t *s)
+static void report_emit(struct status_record *rec)
 {
-    int err;
+    const uint8_t *bytes = (const uint8_t *)rec;
 
-    if (s == NULL) {
-        return -EINVAL;
-    }
-    //Init samples
-    s->raw = 0;
-    s->mv = 0;
-    s->temp_centi = 0;
-    s->valid = false;
+    rec->sync[0] = STATUS_RECORD_SYNC0;
+    rec->sync[1] = STATUS_RECORD_SYNC1;
+    rec->version = STATUS_RECORD_VERSION;
+    rec->len     = sizeof(*rec) - offsetof(struct status_record, uptime_ms) - 1;
+    rec->crc     = status_crc8(&rec->version, offsetof(struct status_record, crc) -
+                                              offsetof(struct status_record, version));
 
-    //Check ADC Ready
-    if (!adc_is_ready_dt(&adc_channel)) {
-        printk("ADC %s is not ready\n", adc_channel.dev->name);
-        return -EIO;
+    for (size_t i = 0; i < sizeof(*rec); i++) {
+        uart_poll_out(report_uart, bytes[i]);
     }
+}
+#endif
 
-    if (!adc_setup_done) {              //ADC Setup
-        err = adc_channel_setup_dt(&adc_channel);
-        if (err < 0) {
-            printk("ADC channel setup failed (err=%d)\n", err);
-            return err;
-        }
-        adc_setup_done = true;
-    }
+// Reporting Function
+static void report_status(void)
+{
+    int64_t now_ms = k_uptime_get();
 
-    struct adc_sequence sequence = {    //Read config
-        .buffer = &adc_buf,
-        .buffer_size = sizeof(adc_buf),
+    state_snapshot_t snap;
+    system_state_t st;
+    int16_t thresh_centi;
+    uint32_t acq_wake, acq_n, logic_wake, overruns;
+    uint32_t led_rate, ble_n, latency_us;
+    static uint32_t last_led_wakeups;
+    static int64_t  last_report_ms;
+
+    state_read(&snap);
+    st           = snap.state;
+    thresh_centi = snap.threshold_centi;
+
+    acq_wake   = acq_wakeups;
+    acq_n      = acq_samples;
+    logic_wake = logic_wakeups;
+    overruns   = (uint32_t)atomic_get(&ring_overruns);
+    ble_n      = ble_updates;
+    latency_us = (uint32_t)atomic_set(&block_latency_us, 0);
+
+    // LED timer wake-ups per minute since the last report
+    uint32_t led_now = led_wakeups;
+    int64_t  span_ms = now_ms - last_report_ms;
+    led_rate = (span_ms > 0) ? (uint32_t)(((int64_t)(led_now - last_led_wakeups) * 60000) / span_ms) : 0;
+    last_led_wakeups = led_now;
+    last_report_ms   = now_ms;
+
+#if STATUS_REPORT_BINARY
+    struct status_record rec = {
+        .uptime_ms        = sys_cpu_to_le32((uint32_t)now_ms),
+        .state            = (uint8_t)st,
+        .num_channels     = NUM_CHANNELS,
+        .thresh_centi     = sys_cpu_to_le16(thresh_centi),
+        .acq_wakeups      = sys_cpu_to_le32(acq_wake),
+        .logic_wakeups    = sys_cpu_to_le32(logic_wake),
+        .acq_samples      = sys_cpu_to_le32(acq_n),
+        .overruns         = sys_cpu_to_le32(overruns),
+        .led_rate         = sys_cpu_to_le16((uint16_t)MIN(led_rate, UINT16_MAX)),
+        .led_polling_rate = sys_cpu_to_le16((uint16_t)led_polling_wakeups_per_min(st)),
+        .adv_interval_ms  = sys_cpu_to_le16((uint16_t)((adv_param.interval_min * 5U) / 8U)),
+        .ble_updates      = sys_cpu_to_le32(ble_n),
+        .latency_us       = sys_cpu_to_le32(latency_us),
     };
 
-    err = adc_sequence_init_dt(&adc_channel, &sequence);      
-    if (err < 0) {
-        printk("ADC sequence init failed (err=%d)\n", err);
-        return err;
-    }
-
-    err = adc_read(adc_channel.dev, &sequence);    
-    if (err < 0) {
-        printk("ADC read failed (err=%d)\n", err);
-        return err;
-    }
-
-    s->raw = adc_buf;  //Stores results
-    s->mv = s->raw;
-
-    err = adc_raw_to_millivolts_dt(&adc_channel, &s->mv);   //Converts from raw to mv
-    if (err < 0) {
-        printk("mV conversion failed\n");
-        return err;
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        const channel_snapshot_t *ch = &snap.ch[c];
+
+        rec.ch[c].state            = (uint8_t)ch->state;
+        rec.ch[c].flags            = (ch->drift_detected ? STATUS_FLAG_DRIFT : 0) |
+                                     (ch->drift_ref_valid ? STATUS_FLAG_DRIFT_REF : 0);
+        rec.ch[c].avg_centi        = sys_cpu_to_le16(ch->avg_temp_centi);
+        rec.ch[c].latest_centi     = sys_cpu_to_le16(ch->latest_temp_centi);
+        rec.ch[c].mv               = sys_cpu_to_le32(ch->latest_mv);
+        rec.ch[c].drift_mean_centi = sys_cpu_to_le32(ch->drift_mean_centi);
+        rec.ch[c].drift_ref_centi  = sys_cpu_to_le32(ch->drift_ref_centi);
     }
 
-    s->temp_centi = (int16_t)((s->mv * 10) - 27315);
+    report_emit(&rec);
+#else
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        const channel_snapshot_t *ch = &snap.ch[c];
 
-    if (s->mv < 0 || s->temp_centi < -4000 || s->temp_centi > 10000) {
-        s->valid = false;
-        return -ERANGE;
+        if (ch->state == STATE_FAULT) {
+            printk("[%lld ms] CH%d Avg: --.-C | Voltage: %d mV | Mode: %s\n",
+                   now_ms, c, ch->latest_mv, state_to_string(ch->state));
+        } else {
+            printk("[%lld ms] CH%d Avg: %d.%02dC | Latest: %d.%02dC | Base: %d.%02dC | Ref: %d.%02dC | Drift: %s | Mode: %s\n",
+                   now_ms, c,
+                   ch->avg_temp_centi / 100, ABS(ch->avg_temp_centi % 100),
+                   ch->latest_temp_centi / 100, ABS(ch->latest_temp_centi % 100),
+                   (int16_t)(ch->drift_mean_centi / 100), ABS((int16_t)(ch->drift_mean_centi % 100)),
+                   ch->drift_ref_valid ? (int16_t)(ch->drift_ref_centi / 100) : 0,
+                   ch->drift_ref_valid ? ABS((int16_t)(ch->drift_ref_centi % 100)) : 0,
+                   ch->drift_detected ? "YES" : "NO",
+                   state_to_string(ch->state));
+        }
     }
 
-    s->valid = true;
-    return 0;
+    printk("[%lld ms] Mode: %s | Thresh: %d.%02dC | LED: %s | Wakeups: acq %u logic %u / %u samples | Overruns: %u | Latency: %u us | LED wakeups/min: %u (polling %u) | BLE: %u updates @ %u ms\n",
+           now_ms,
+           state_to_string(st),
+           thresh_centi / 100, ABS(thresh_centi % 100),
+           led_to_string(st),
+           acq_wake, logic_wake, acq_n, overruns, latency_us,
+           led_rate, led_polling_wakeups_per_min(st),
+           ble_n, (adv_param.interval_min * 5U) / 8U);
+#endif
 }
 
-// Logic Function
-static void process_sample(const sample_t *s)
+#if BLE_ADAPTIVE_ADV
+// Rebuilds the advert when logic signalled a change (changed) and adapts the
+// interval: fast while any channel is not NORMAL, doubling while stable
+static void ble_update(bool changed)
 {
-    if (s == NULL) {
-        return;
-    } 
-    if (!s->valid) {
-        SEGGER_SYSVIEW_PrintfHost("State change: %s -> FAULT", state_to_string(system_state));
-        system_state = STATE_FAULT;
-        return;
-    } 
-    
-    latest_temp_centi = s->temp_centi;
-    latest_mv         = s->mv;
-
-    // decimate
-    temp_avg.decimate_sum += s->temp_centi;
-    temp_avg.decimate_count++;
-
-    if (temp_avg.decimate_count >= DECIMATE_FACTOR) {
-        int16_t decimated = (int16_t)(temp_avg.decimate_sum / DECIMATE_FACTOR);
-        temp_avg.decimate_sum   = 0;
-        temp_avg.decimate_count = 0;
-
-        if (temp_avg.valid_samples < AVG_WINDOW_SAMPLES) {
-            temp_avg.buffer[temp_avg.index] = decimated;
-            temp_avg.sum_centi += decimated;
-            temp_avg.valid_samples++;
-        } else {
-            temp_avg.sum_centi -= temp_avg.buffer[temp_avg.index];
-            temp_avg.buffer[temp_avg.index] = decimated;
-            temp_avg.sum_centi += decimated;
-        }
-
-        temp_avg.index = (temp_avg.index + 1) % AVG_WINDOW_SAMPLES;
-    }
+    static uint16_t interval = BT_ADV_INTERVAL;
+    state_snapshot_t snap;
+    uint16_t next;
+    int err;
 
-    if (temp_avg.valid_samples > 0) {
-        avg_temp_centi = (int16_t)(temp_avg.sum_centi / (int32_t)temp_avg.valid_samples);
-    } 
-    
-    minute_sample_counter++;
+    state_read(&snap);
 
-    if (minute_sample_counter >= DRIFT_UPDATE_SAMPLES) {
-        minute_sample_counter = 0;
+    if (changed) {
+        ble_fill_payload(&snap);
 
-        if (environment_is_stable(avg_temp_centi, latest_temp_centi) &&
-            avg_temp_centi <= warning_threshold_centi) {
-            update_drift_welford(avg_temp_centi);
+        err = bt_le_adv_update_data(ad, ARRAY_SIZE(ad), NULL, 0);
+        if (err) {
+            printk("BLE update failed (err=%d)\n", err);
         }
+        ble_updates++;
     }
 
-    if (drift_detected) {
-        system_state = STATE_DRIFT;
-    } else if (avg_temp_centi > warning_threshold_centi) {
-        system_state = STATE_WARNING;
+    if (snap.state != STATE_NORMAL) {
+        next = BT_ADV_INTERVAL_MIN;     // WARNING/FAULT/DRIFT: fast straight away
+    } else if (!changed) {
+        next = MIN(interval * 2, BT_ADV_INTERVAL_MAX);
     } else {
-        system_state = STATE_NORMAL;
+        next = interval;
+    }
+
+    if (next != interval) {
+        err = ble_set_interval(next);
+        if (err) {
+            printk("BLE interval change failed (err=%d)\n", err);
+        } else {
+            interval = next;
+        }
     }
 }
+#else
+// Rebuilds the advert from the latest snapshot, FAULT keeps the last one
+static void ble_update(bool changed)
+{
+    ARG_UNUSED(changed);
 
+    state_snapshot_t snap;
+    int err;
 
-// Reporting Function
-static void report_status(void)
-{
-    int64_t now_ms = k_uptime_get();
+    state_read(&snap);
 
-    system_state_t st;
-    int16_t avg_centi, latest_centi, thresh_centi;
-    int32_t mv;
-    int32_t drift_mean_local, drift_ref_local;
-    bool drift_local, drift_ref_ok;
-
-    k_mutex_lock(&state_mutex, K_FOREVER);
-    st               = system_state;
-    avg_centi        = avg_temp_centi;
-    latest_centi     = latest_temp_centi;
-    thresh_centi     = warning_threshold_centi;
-    drift_mean_local = drift_mean_centi;
-    drift_ref_local  = drift_ref_centi;
-    drift_ref_ok     = drift_ref_valid;
-    drift_local      = drift_detected;
-    mv               = latest_mv;
-    k_mutex_unlock(&state_mutex);
-
-    if (st == STATE_FAULT) {
-        printk("[%lld ms] Avg: --.-C | Voltage: %d mV | Mode: %s | LED: %s\n",
-               now_ms,
-               mv,
-               state_to_string(st),
-               led_to_string(st));
-    } else {
-        printk("[%lld ms] Avg: %d.%02dC | Latest: %d.%02dC | Thresh: %d.%02dC | Base: %d.%02dC | Ref: %d.%02dC | Drift: %s | Mode: %s | LED: %s\n",
-                now_ms,
-                avg_centi / 100, ABS(avg_centi % 100),
-                latest_centi / 100, ABS(latest_centi % 100),
-                thresh_centi / 100, ABS(thresh_centi % 100),
-                (int16_t)(drift_mean_local / 100), ABS((int16_t)(drift_mean_local % 100)),
-                drift_ref_ok ? (int16_t)(drift_ref_local / 100) : 0,
-                drift_ref_ok ? ABS((int16_t)(drift_ref_local % 100)) : 0,
-                drift_local ? "YES" : "NO",
-                state_to_string(st),
-                led_to_string(st));
+    if (snap.state == STATE_FAULT) {
+        return;
+    }
+
+    ble_fill_payload(&snap);
+
+    err = bt_le_adv_update_data(ad, ARRAY_SIZE(ad), NULL, 0);
+    if (err) {
+        printk("BLE update failed (err=%d)\n", err);
     }
+    ble_updates++;
 }
+#endif
 
+#if !CW1_EVENT_LOOP
 // Thread Functions
 //BLE Thread- Updates the BLE payload with latest average temp and state
 void ble_thread(void *p1, void *p2, void *p3)
@@ -413,33 +1279,80 @@ void ble_thread(void *p1, void *p2, void *p3)
             continue;
         }
 
-        system_state_t st;
-        int16_t avg_centi;
-        int err;
+#if BLE_ADAPTIVE_ADV
+        // woken by ble_notify(), or times out when the value is stable
+        bool changed = (k_sem_take(&ble_update_sem, K_MSEC(BLE_STABLE_PERIOD_MS)) == 0);
 
-        k_mutex_lock(&state_mutex, K_FOREVER);
-        st = system_state;
-        avg_centi = avg_temp_centi;
-        k_mutex_unlock(&state_mutex);
+        history_burst_poll();
+        ble_update(changed);
+#else
+        history_burst_poll();
+        ble_update(true);
+        k_sleep(K_MSEC(BLE_UPDATE_PERIOD_MS));
+#endif
+    }
+}
 
-        if (st == STATE_FAULT) {
-            k_sleep(K_MSEC(BLE_UPDATE_PERIOD_MS));
-            continue;
-        }
+#if ACQ_STREAMING
+// Aquisition Thread (streaming) - keeps a sequence over both halves of
+// stream_buf running and re-arms it as soon as it completes, so it wakes once
+// per two blocks. The halves reach logic from stream_scan_done().
+void acquisition_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
 
-        adv_mfg_data.avg_temp_x100 = sys_cpu_to_be16(avg_centi);
-        adv_mfg_data.state = (uint8_t)st;
+    struct k_poll_event done_evt = K_POLL_EVENT_INITIALIZER(
+        K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &stream_done_sig);
 
-        err = bt_le_adv_update_data(ad, ARRAY_SIZE(ad), NULL, 0);
-        if (err) {
-            printk("BLE update failed (err=%d)\n", err);
+    const struct adc_sequence_options options = {
+        .interval_us     = STREAM_INTERVAL_US,
+        .callback        = stream_scan_done,
+        .extra_samplings = 2 * STREAM_HALF_SCANS - 1,
+    };
+
+    struct adc_sequence sequence = {
+        .options = &options,
+        .buffer = stream_buf,
+        .buffer_size = sizeof(stream_buf),
+    };
+
+    k_poll_signal_init(&stream_done_sig);
+
+    while (1) {
+        unsigned int signaled;
+        int err = adc_prepare();
+
+        if (err == 0) {
+            err = adc_sequence_init_dt(&adc_channels[0], &sequence);
+            sequence.channels = adc_channel_mask;
+            if (CONFIG_CW1_ADC_OVERSAMPLING > 0) {
+                sequence.oversampling = CONFIG_CW1_ADC_OVERSAMPLING;
+            }
         }
+        if (err == 0) {
+            k_poll_signal_reset(&stream_done_sig);
+            done_evt.state = K_POLL_STATE_NOT_READY;
+            err = adc_read_async(adc_channels[0].dev, &sequence, &stream_done_sig);
+        }
+        if (err == 0) {
+            k_poll(&done_evt, 1, K_FOREVER);
+            k_poll_signal_check(&stream_done_sig, &signaled, &err);
+        }
+        acq_wakeups++;
 
-        k_sleep(K_MSEC(BLE_UPDATE_PERIOD_MS));
+        if (err < 0) {
+            // logic turns this into a block of invalid samples (FAULT)
+            printk("ADC stream failed (err=%d)\n", err);
+            atomic_set_bit(&stream_ready, STREAM_FAILED_BIT);
+            k_sem_give(&sample_ring_sem);
+            k_sleep(K_MSEC(ACQ_BLOCK_PERIOD_MS));
+        }
     }
 }
-
-// Aquisition Thread - Runs every 100ms- takes 1 sample- sends to logic thread
+#else
+// Aquisition Thread - Runs every block period- takes a block of samples- sends to logic thread
 void acquisition_thread(void *p1, void *p2, void *p3)
 {
     ARG_UNUSED(p1);
@@ -449,34 +1362,168 @@ void acquisition_thread(void *p1, void *p2, void *p3)
     while (1) {
         
         k_sem_take(&sample_sem, K_FOREVER);
+        acq_wakeups++;
 
-        sample_t s = {0};
-        int err = acquire_sample(&s);
-        if (err < 0) {
-            s.valid = false;
+        // take ownership of a free slot, skip the block if logic holds them all
+        sample_block_t *blk = spsc_acquire(&sample_ring);
+        if (blk == NULL) {
+            atomic_inc(&ring_overruns);
+            continue;
+        }
+
+        // a failed read comes back as a block of invalid samples (FAULT)
+        (void)acquire_block(blk);
+        acq_samples += blk->count;
+
+        // hand the slot to logic
+        spsc_produce(&sample_ring);
+        k_sem_give(&sample_ring_sem);
+    }
+}
+#endif
+#endif
+
+// Runs one block through every channel's pipeline (logic thread only)
+static void logic_process_block(sample_t (*samples)[NUM_CHANNELS], uint8_t count)
+{
+    if (calibration_requested) {
+        apply_calibration();
+        state_publish();
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        system_state_t worst = STATE_NORMAL;
+
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            if (!samples[i][c].valid) {
+                SEGGER_SYSVIEW_PrintfHost("State change: CH%d %s -> FAULT", c,
+                                          state_to_string(proc[c].system_state));
+            }
+#if defined(CW1_REPLAY)
+            system_state_t prev = proc[c].system_state;
+#endif
+            process_sample(&proc[c], &samples[i][c]);
+#if defined(CW1_REPLAY)
+            if (proc[c].system_state != prev) {
+                printk("[%lld ms] CH%d State: %s -> %s (avg %d.%02dC)\n", k_uptime_get(), c,
+                       state_to_string(prev), state_to_string(proc[c].system_state),
+                       proc[c].avg_temp_centi / 100, ABS(proc[c].avg_temp_centi % 100));
+            }
+#endif
+            worst = state_worst(worst, proc[c].system_state);
         }
 
-        // send sample to logic
-        int q_err = k_msgq_put(&sample_msgq, &s, K_NO_WAIT);
-        if (q_err != 0) {
-            printk("sample_msgq put failed (err=%d)\n", q_err);
+        node_state = worst;
+        state_publish();
+        history_update();
+        led_update(node_state);
+#if BLE_ADAPTIVE_ADV
+        ble_notify();
+#endif
+    }
+}
+
+// Keeps the worst ADC completion -> block processed time for the status report
+static void block_latency_note(uint32_t done_cyc)
+{
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - done_cyc);
+    atomic_val_t max;
+
+    // report_status() resets the maximum concurrently, retry if it moved
+    do {
+        max = atomic_get(&block_latency_us);
+        if (us <= (uint32_t)max) {
+            return;
+        }
+    } while (!atomic_cas(&block_latency_us, max, (atomic_val_t)us));
+}
+
+#if ACQ_STREAMING
+// Averages and processes every half the ADC has filled, oldest first. A half
+// is given back to the ADC before it is processed.
+static void stream_consume(void)
+{
+    if (atomic_test_and_clear_bit(&stream_ready, STREAM_FAILED_BIT)) {
+        // the next sequence starts over at half 0
+        atomic_clear_bit(&stream_ready, 0);
+        atomic_clear_bit(&stream_ready, 1);
+        stream_next_half = 0;
+
+        memset(stream_samples, 0, sizeof(stream_samples));
+        acq_samples += ACQ_BATCH_SAMPLES;
+        logic_process_block(stream_samples, ACQ_BATCH_SAMPLES);
+    }
+
+    for (int n = 0; n < 2; n++) {
+        int half = stream_next_half;
+
+        if (!atomic_test_bit(&stream_ready, half)) {
+            half ^= 1;
+            if (!atomic_test_bit(&stream_ready, half)) {
+                break;
+            }
         }
+
+        stream_decimate(stream_buf[half], stream_samples);
+        atomic_clear_bit(&stream_ready, half);
+        stream_next_half = half ^ 1;
+
+        acq_samples += ACQ_BATCH_SAMPLES;
+        logic_process_block(stream_samples, ACQ_BATCH_SAMPLES);
+        block_latency_note(stream_done_cyc[half]);
+    }
+}
+#endif
+
+// Logic state before the first block, readers see the default threshold
+static void logic_init(void)
+{
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        thermal_proc_init(&proc[c], DEFAULT_TEMP_THRESHOLD_CENTI);
+    }
+    history_init(&history, NUM_CHANNELS);
+    state_publish();
+}
+
+// One status report, ends a replay run once the trace is used up
+static void report_tick(void)
+{
+    report_status();
+
+#if defined(CW1_REPLAY)
+    if (replay_finished()) {
+        printk("Replay finished after %u samples\n", replay_position());
+        nsi_exit(0);
     }
+#endif
 }
 
-// logic Thread - waits for sample from aquisition thread- processes it- updates shared state
+#if !CW1_EVENT_LOOP
+// logic Thread - waits for a block from aquisition thread- processes it- updates shared state
 void logic_thread(void *p1, void *p2, void *p3)
 {
     ARG_UNUSED(p1); ARG_UNUSED(p2); ARG_UNUSED(p3);
 
-    sample_t s;
+    logic_init();
 
     while (1) {
-        k_msgq_get(&sample_msgq, &s, K_FOREVER);
+        k_sem_take(&sample_ring_sem, K_FOREVER);
+        logic_wakeups++;
+
+#if ACQ_STREAMING
+        stream_consume();
+#else
+        sample_block_t *blk = spsc_consume(&sample_ring);
+        if (blk == NULL) {
+            continue;
+        }
 
-        k_mutex_lock(&state_mutex, K_FOREVER);
-        process_sample(&s);
-        k_mutex_unlock(&state_mutex);
+        logic_process_block(blk->samples, blk->count);
+        block_latency_note(blk->done_cyc);
+
+        // return the slot to acquisition
+        spsc_release(&sample_ring);
+#endif
     }
 }
 
@@ -490,31 +1537,9 @@ void reporting_thread(void *p1, void *p2, void *p3)
     int64_t next = k_uptime_get();
 
     while (1) {
-        if (calibration_requested) {
-            k_mutex_lock(&state_mutex, K_FOREVER);
-
-            if (warning_threshold_centi == 2600) {
-                warning_threshold_centi = 2800;
-            } else if (warning_threshold_centi == 2800) {
-                warning_threshold_centi = 3000;
-            } else if (warning_threshold_centi == 3000) {
-                warning_threshold_centi = 3200;
-            } else {
-                warning_threshold_centi = 2600;
-            }
+        report_tick();
 
-            calibration_requested = false;
-
-            printk("Calibration: threshold set to %d.%02dC\n",
-                   warning_threshold_centi / 100,
-                   ABS(warning_threshold_centi % 100));
-
-            k_mutex_unlock(&state_mutex);
-        }
-
-        report_status();
-
-        next += 1000;
+        next += REPORT_PERIOD_MS;
         int64_t now = k_uptime_get();
         int64_t delay = next - now;
         if (delay < 0) {
@@ -524,48 +1549,207 @@ void reporting_thread(void *p1, void *p2, void *p3)
         k_sleep(K_MSEC(delay));
     }
 }
-// LED Thread- Sets LED mode based on system state (off, blinking, solid)
-void led_thread(void *p1, void *p2, void *p3)
+// Thread Definitions - 5 is lowest priortiy 1 is highest
+#define STACK_SIZE CONFIG_CW1_THREAD_STACK_SIZE
+#define ACQ_PRIO   CONFIG_CW1_ACQ_PRIORITY      // Highest priortiy
+#define LOGIC_PRIO CONFIG_CW1_LOGIC_PRIORITY
+#define REP_PRIO   CONFIG_CW1_REPORT_PRIORITY
+#define BLE_PRIO   CONFIG_CW1_BLE_PRIORITY      // Lowest priority
+
+// all four are preemptible, and acquisition must be able to preempt logic
+// so a block is never late because one is being processed
+BUILD_ASSERT(ACQ_PRIO >= 0 && BLE_PRIO < CONFIG_NUM_PREEMPT_PRIORITIES &&
+             LOGIC_PRIO < CONFIG_NUM_PREEMPT_PRIORITIES &&
+             REP_PRIO < CONFIG_NUM_PREEMPT_PRIORITIES,
+             "CW_1 thread priorities must be preemptible");
+BUILD_ASSERT(ACQ_PRIO < LOGIC_PRIO, "acquisition must outrank logic");
+BUILD_ASSERT(STACK_SIZE >= 512, "CW_1 threads call printk, keep at least 512 bytes");
+
+K_THREAD_DEFINE(acq_tid,   STACK_SIZE, acquisition_thread, NULL, NULL, NULL, ACQ_PRIO,   0, 0);
+K_THREAD_DEFINE(logic_tid, STACK_SIZE, logic_thread,       NULL, NULL, NULL, LOGIC_PRIO, 0, 0);
+K_THREAD_DEFINE(rep_tid,   STACK_SIZE, reporting_thread,   NULL, NULL, NULL, REP_PRIO,   0, 0);
+K_THREAD_DEFINE(ble_tid,   STACK_SIZE, ble_thread,         NULL, NULL, NULL, BLE_PRIO,   0, 0);
+#else
+// Event loop (main thread). Acquisition and logic become one handler pair
+// around an asynchronous block read; reporting and BLE run when their
+// deadline comes up, which is also the k_poll timeout. The LED needs no
+// handler: led_timer blinks it and logic reprograms it on a transition.
+BUILD_ASSERT(CONFIG_MAIN_STACK_SIZE >= CONFIG_CW1_THREAD_STACK_SIZE,
+             "main runs every handler, give it at least a thread's stack");
+
+#if BLE_ADAPTIVE_ADV
+#define LOOP_BLE_PERIOD_MS  BLE_STABLE_PERIOD_MS     // no change for this long -> back off
+#else
+#define LOOP_BLE_PERIOD_MS  BLE_UPDATE_PERIOD_MS
+#endif
+
+enum {
+    LOOP_EVT_ADC,           // loop_block sequence finished
+    LOOP_EVT_SAMPLE,        // sample_timer tick
+    LOOP_EVT_BUTTON,
+#if BLE_ADAPTIVE_ADV
+    LOOP_EVT_BLE,           // ble_notify()
+#endif
+#if defined(CONFIG_BT_EXT_ADV)
+    LOOP_EVT_HISTORY,       // history chunk sent
+#endif
+    LOOP_EVT_COUNT
+};
+
+// Processes loop_block, or a block of invalid samples (FAULT) when err < 0
+static void loop_block_done(int err)
+{
+    logic_wakeups++;
+    block_convert(&loop_block, err);
+    acq_samples += loop_block.count;
+
+    logic_process_block(loop_block.samples, loop_block.count);
+    block_latency_note(loop_block.done_cyc);
+}
+
+// sample_timer tick: starts the next block, LOOP_EVT_ADC fires when it is in
+static void loop_sample_tick(void)
 {
-    ARG_UNUSED(p1); ARG_UNUSED(p2); ARG_UNUSED(p3);
+    static struct adc_sequence sequence;    // the driver holds on to it until done
+    int err;
 
-    while (1) {
-        system_state_t st;
+    (void)k_sem_take(&sample_sem, K_NO_WAIT);
+    acq_wakeups++;
 
-        k_mutex_lock(&state_mutex, K_FOREVER);
-        st = system_state;
-        k_mutex_unlock(&state_mutex);
+    if (adc_busy) {
+        atomic_inc(&ring_overruns);
+        return;
+    }
 
-        if (st == STATE_NORMAL) {
-            gpio_pin_set_dt(&led0, 0);      // OFF
-            k_sleep(K_MSEC(100));
-        } else if (st == STATE_WARNING || st == STATE_DRIFT) {
-            gpio_pin_set_dt(&led0, 1);
-            k_sleep(K_MSEC(50));
-            gpio_pin_set_dt(&led0, 0);
-            k_sleep(K_MSEC(50));
-        } else if (st == STATE_FAULT) {
-            gpio_pin_set_dt(&led0, 1);
-            k_sleep(K_MSEC(200));
-        } else {
-            k_sleep(K_MSEC(100));
+    err = block_sequence_init(&loop_block, &sequence);
+    if (err == 0) {
+        k_poll_signal_reset(&adc_done_sig);
+        err = adc_read_async(adc_channels[0].dev, &sequence, &adc_done_sig);
+        if (err == 0) {
+            adc_busy = true;
+            return;
         }
+        printk("ADC read failed (err=%d)\n", err);
     }
+    loop_block_done(err);
 }
 
-// Thread Definitions - 5 is lowest priortiy 1 is highest
-#define STACK_SIZE 1024
-#define ACQ_PRIO   1    // Highest priortiy
-#define LOGIC_PRIO 2
-#define LED_PRIO   3
-#define REP_PRIO   4
-#define BLE_PRIO   5    // Lowest priority
+static void loop_adc_done(void)
+{
+    unsigned int signaled;
+    int err;
 
-K_THREAD_DEFINE(acq_tid,   STACK_SIZE, acquisition_thread, NULL, NULL, NULL, ACQ_PRIO,   0, 0);
-K_THREAD_DEFINE(logic_tid, STACK_SIZE, logic_thread,       NULL, NULL, NULL, LOGIC_PRIO, 0, 0);
-K_THREAD_DEFINE(led_tid,   STACK_SIZE, led_thread,         NULL, NULL, NULL, LED_PRIO,   0, 0);
-K_THREAD_DEFINE(rep_tid,   STACK_SIZE, reporting_thread,   NULL, NULL, NULL, REP_PRIO,   0, 0);
-K_THREAD_DEFINE(ble_tid,   STACK_SIZE, ble_thread,         NULL, NULL, NULL, BLE_PRIO,   0, 0);
+    k_poll_signal_check(&adc_done_sig, &signaled, &err);
+    k_poll_signal_reset(&adc_done_sig);
+    adc_busy = false;
+
+    if (err < 0) {
+        printk("ADC read failed (err=%d)\n", err);
+    }
+    loop_block_done(err);
+}
+
+// Calibration is applied right away instead of with the next block
+static void loop_button(void)
+{
+    k_poll_signal_reset(&button_sig);
+
+    if (calibration_requested) {
+        apply_calibration();
+        state_publish();
+    }
+}
+
+static void loop_ble(bool changed)
+{
+    if (!ble_started) {
+        return;
+    }
+    history_burst_poll();
+    ble_update(changed);
+}
+
+static k_timeout_t loop_timeout(int64_t due_ms)
+{
+    int64_t delay = due_ms - k_uptime_get();
+
+    return (delay > 0) ? K_MSEC(delay) : K_NO_WAIT;
+}
+
+static void event_loop(void)
+{
+    struct k_poll_event events[LOOP_EVT_COUNT] = {
+        [LOOP_EVT_ADC] = K_POLL_EVENT_INITIALIZER(
+            K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &adc_done_sig),
+        [LOOP_EVT_SAMPLE] = K_POLL_EVENT_INITIALIZER(
+            K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &sample_sem),
+        [LOOP_EVT_BUTTON] = K_POLL_EVENT_INITIALIZER(
+            K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &button_sig),
+#if BLE_ADAPTIVE_ADV
+        [LOOP_EVT_BLE] = K_POLL_EVENT_INITIALIZER(
+            K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &ble_update_sem),
+#endif
+#if defined(CONFIG_BT_EXT_ADV)
+        [LOOP_EVT_HISTORY] = K_POLL_EVENT_INITIALIZER(
+            K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &history_sent_sem),
+#endif
+    };
+    int64_t report_due = k_uptime_get();
+    int64_t ble_due = report_due + LOOP_BLE_PERIOD_MS;
+
+    while (1) {
+        int64_t due = MIN(report_due, ble_due);
+
+#if defined(CONFIG_BT_EXT_ADV)
+        if (history_tx.active) {
+            due = MIN(due, history_tx.deadline_ms);
+        }
+#endif
+        for (int i = 0; i < LOOP_EVT_COUNT; i++) {
+            events[i].state = K_POLL_STATE_NOT_READY;
+        }
+        (void)k_poll(events, LOOP_EVT_COUNT, loop_timeout(due));
+
+        // a finished block first, so the next tick finds the ADC free
+        if (events[LOOP_EVT_ADC].state == K_POLL_STATE_SIGNALED) {
+            loop_adc_done();
+        }
+        if (events[LOOP_EVT_SAMPLE].state == K_POLL_STATE_SEM_AVAILABLE) {
+            loop_sample_tick();
+        }
+        if (events[LOOP_EVT_BUTTON].state == K_POLL_STATE_SIGNALED) {
+            loop_button();
+        }
+#if defined(CONFIG_BT_EXT_ADV)
+        if (events[LOOP_EVT_HISTORY].state == K_POLL_STATE_SEM_AVAILABLE) {
+            (void)k_sem_take(&history_sent_sem, K_NO_WAIT);
+            history_burst_step();
+        }
+        history_burst_timeout();
+#endif
+
+        int64_t now = k_uptime_get();
+
+#if BLE_ADAPTIVE_ADV
+        if (events[LOOP_EVT_BLE].state == K_POLL_STATE_SEM_AVAILABLE) {
+            (void)k_sem_take(&ble_update_sem, K_NO_WAIT);
+            loop_ble(true);
+            ble_due = now + LOOP_BLE_PERIOD_MS;
+        }
+#endif
+        // no change for a period: adaptive backs off, periodic rebuilds
+        if (now >= ble_due) {
+            loop_ble(!BLE_ADAPTIVE_ADV);
+            ble_due = now + LOOP_BLE_PERIOD_MS;
+        }
+
+        if (now >= report_due) {
+            report_tick();
+            report_due += REPORT_PERIOD_MS;
+        }
+    }
+}
+#endif
 
 //main
 int main(void)
@@ -574,6 +1758,10 @@ int main(void)
 
     printk("CW_1 Thermal Monitoring \n");
 
+#if CW1_EVENT_LOOP
+    logic_init();       // logic runs in this thread, before BLE reads the snapshot
+#endif
+
     if (!gpio_is_ready_dt(&led0)) {     //Check LED Ready
         printk("LED device not ready\n");
         return 0;
@@ -605,23 +1793,53 @@ int main(void)
     gpio_init_callback(&button_cb_data, button_pressed, BIT(button0.pin));
     gpio_add_callback(button0.port, &button_cb_data);
 
+    // Monitoring keeps running without BLE (e.g. native_sim without an HCI device)
     err = bt_enable(NULL);  // Start bluetooth
     if (err) {
-        printk("Bluetooth init failed (err=%d)\n", err);
-        return 0;
-    }
+        printk("Bluetooth init failed (err=%d), continuing without BLE\n", err);
+    } else {
+        state_snapshot_t snap;
 
-    err = bt_le_adv_start(adv_param, ad, ARRAY_SIZE(ad), NULL, 0);  //Start advertising
-    if (err) {
-        printk("Advertising failed to start (err=%d)\n", err);
-        return 0;
+        state_read(&snap);
+        ble_fill_payload(&snap);
+
+#if defined(CONFIG_BT_EXT_ADV)
+        err = history_adv_init();
+        if (err) {
+            printk("History advertising set failed (err=%d), no bursts\n", err);
+            history_adv = NULL;
+        }
+#endif
+
+        err = bt_le_adv_start(&adv_param, ad, ARRAY_SIZE(ad), NULL, 0);  //Start advertising
+        if (err) {
+            printk("Advertising failed to start (err=%d)\n", err);
+        } else {
+            ble_started = true;  //Allows BLE thread to advertise
+        }
     }
-    ble_started = true;  //Allows BLE thread to advertise
     
+    printk("Filter: %s, decimation %d, hw oversampling x%d\n",
+           decim_filter_name(DECIMATE_FILTER), DECIMATE_FACTOR, 1 << CONFIG_CW1_ADC_OVERSAMPLING);
+
+#if ACQ_STREAMING
+    printk("Acquisition: streaming, %d scans/s, %d averaged per sample, %d samples per block\n",
+           USEC_PER_SEC / STREAM_INTERVAL_US, STREAM_OVERSAMPLE, ACQ_BATCH_SAMPLES);
+#else
+    printk("Acquisition: %d samples per block every %d ms\n",
+           ACQ_BATCH_SAMPLES, ACQ_BLOCK_PERIOD_MS);
+
     k_timer_init(&sample_timer, sample_timer_handler, NULL);
-    k_timer_start(&sample_timer, K_MSEC(SAMPLE_PERIOD_MS), K_MSEC(SAMPLE_PERIOD_MS));
+    k_timer_start(&sample_timer, K_MSEC(ACQ_BLOCK_PERIOD_MS), K_MSEC(ACQ_BLOCK_PERIOD_MS));
+#endif
 
+#if CW1_EVENT_LOOP
+    printk("Threads: one event loop\n");
+    event_loop();
+#else
     while (1) {
         k_sleep(K_FOREVER); //Main can sleep as threads running
     }
+#endif
+    return 0;
 }
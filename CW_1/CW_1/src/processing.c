@@ -0,0 +1,161 @@
+/* CW_1 processing pipeline, see processing.h */
+#include "processing.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(AVG_WINDOW_SAMPLES >= 1 && AVG_WINDOW_SAMPLES <= UINT16_MAX,
+               "AVG_WINDOW_SAMPLES must fit the uint16_t index");
+_Static_assert((int64_t)AVG_WINDOW_SAMPLES * INT16_MAX <= INT32_MAX,
+               "window sum must fit sum_centi");
+_Static_assert(DRIFT_UPDATE_SAMPLES >= 1, "DRIFT_UPDATE_SAMPLES must be positive");
+
+void thermal_proc_init(thermal_proc_t *p, int16_t threshold_centi)
+{
+    memset(p, 0, sizeof(*p));
+    p->system_state = STATE_NORMAL;
+    p->warning_threshold_centi = threshold_centi;
+    decim_filter_init(&p->temp_avg.decimate, DECIMATE_FILTER);
+}
+
+int sample_set_mv(sample_t *s, int32_t mv)
+{
+    s->mv = mv;
+    s->temp_centi = (int16_t)((s->mv * 10) - 27315);
+
+    if (s->mv < 0 || s->temp_centi < -4000 || s->temp_centi > 10000) {
+        s->valid = false;
+        return -ERANGE;
+    }
+
+    s->valid = true;
+    return 0;
+}
+
+bool environment_is_stable(int16_t avg_centi, int16_t latest_centi)
+{
+    return ABS(latest_centi - avg_centi) <= STABLE_BAND_CENTI;
+}
+
+void update_drift_welford(thermal_proc_t *p, int16_t stable_avg_centi)
+{
+    p->drift_count++;
+
+    if (p->drift_count == 1) {
+        p->drift_mean_centi = stable_avg_centi;
+        p->drift_M2 = 0;
+    } else {
+        int32_t delta = stable_avg_centi - p->drift_mean_centi;
+        p->drift_mean_centi += delta / (int32_t)p->drift_count;
+
+        int32_t delta2 = stable_avg_centi - p->drift_mean_centi;
+        p->drift_M2 += (int64_t)delta * (int64_t)delta2;
+    }
+
+    if (!p->drift_ref_valid && p->drift_count >= DRIFT_REF_MIN_UPDATES) {
+        p->drift_ref_centi = p->drift_mean_centi;
+        p->drift_ref_valid = true;
+    }
+
+    if (p->drift_ref_valid &&
+        ABS(p->drift_mean_centi - p->drift_ref_centi) > DRIFT_THRESHOLD_CENTI) {
+        p->drift_detected = true;
+
+        if (p->drift_mean_centi > p->drift_ref_centi) {
+            p->drift_ref_centi -= 200;
+        } else {
+            p->drift_ref_centi += 200;
+        }
+    } else {
+        p->drift_detected = false;
+    }
+}
+
+// Logic Function
+void process_sample(thermal_proc_t *p, const sample_t *s)
+{
+    temp_avg_t *avg = &p->temp_avg;
+
+    if (s == NULL) {
+        return;
+    } 
+    if (!s->valid) {
+        p->system_state = STATE_FAULT;
+        return;
+    } 
+    
+    p->latest_temp_centi = s->temp_centi;
+    p->latest_mv         = s->mv;
+
+    // decimate
+    int16_t decimated;
+
+    if (decim_filter_push(&avg->decimate, s->temp_centi, &decimated)) {
+        if (avg->valid_samples < AVG_WINDOW_SAMPLES) {
+            avg->buffer[avg->index] = decimated;
+            avg->sum_centi += decimated;
+            avg->valid_samples++;
+        } else {
+            avg->sum_centi -= avg->buffer[avg->index];
+            avg->buffer[avg->index] = decimated;
+            avg->sum_centi += decimated;
+        }
+
+#if AVG_WINDOW_POW2
+        avg->index = (avg->index + 1) & (AVG_WINDOW_SAMPLES - 1);
+#else
+        avg->index = (avg->index + 1 == AVG_WINDOW_SAMPLES) ? 0 : avg->index + 1;
+#endif
+    }
+
+    if (avg->valid_samples > 0) {
+        p->avg_temp_centi = (int16_t)(avg->sum_centi / (int32_t)avg->valid_samples);
+    } 
+    
+    p->minute_sample_counter++;
+
+    if (p->minute_sample_counter >= DRIFT_UPDATE_SAMPLES) {
+        p->minute_sample_counter = 0;
+
+        if (environment_is_stable(p->avg_temp_centi, p->latest_temp_centi) &&
+            p->avg_temp_centi <= p->warning_threshold_centi) {
+            update_drift_welford(p, p->avg_temp_centi);
+        }
+    }
+
+    if (p->drift_detected) {
+        p->system_state = STATE_DRIFT;
+    } else if (p->avg_temp_centi > p->warning_threshold_centi) {
+        p->system_state = STATE_WARNING;
+    } else {
+        p->system_state = STATE_NORMAL;
+    }
+}
+
+int16_t thermal_next_threshold(int16_t threshold_centi)
+{
+    if (threshold_centi == 2600) {
+        return 2800;
+    } else if (threshold_centi == 2800) {
+        return 3000;
+    } else if (threshold_centi == 3000) {
+        return 3200;
+    }
+    return 2600;
+}
+
+static int state_severity(system_state_t state)
+{
+    switch (state) {
+    case STATE_WARNING: return 1;
+    case STATE_DRIFT:   return 2;
+    case STATE_FAULT:   return 3;
+    default:            return 0;
+    }
+}
+
+system_state_t state_worst(system_state_t a, system_state_t b)
+{
+    return (state_severity(b) > state_severity(a)) ? b : a;
+}
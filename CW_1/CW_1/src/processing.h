@@ -0,0 +1,115 @@
+/* CW_1 processing pipeline - decimation, 1 min rolling average, Welford
+ * drift tracking and the state decision. No Zephyr dependencies, so it
+ * also builds for native_sim, unit_testing or a plain host compiler.
+ */
+#ifndef CW1_PROCESSING_H
+#define CW1_PROCESSING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "filter.h"
+
+#ifndef ABS
+#define ABS(x) ((x) < 0 ? -(x) : (x))
+#endif
+
+// State definitions
+typedef enum {
+    STATE_NORMAL = 0, // = if the avg temp <= threshold
+    STATE_WARNING,    // = if the1 min Average temp > threshold
+    STATE_FAULT,       // = Incorrect reading
+    STATE_DRIFT
+} system_state_t;
+
+//Sample Struct
+typedef struct {
+    int16_t raw;
+    int32_t mv;
+    int16_t temp_centi;
+    bool    valid;
+} sample_t;
+
+#define DEFAULT_TEMP_THRESHOLD_CENTI 2800  // Temp warning thresh
+
+// Decimation filter in front of the 1 min rolling average (DECIMATE_FACTOR
+// is in filter.h), picked with CONFIG_CW1_FILTER_*
+#if defined(CONFIG_CW1_FILTER_CIC)
+#define DECIMATE_FILTER DECIM_FILTER_CIC
+#elif defined(CONFIG_CW1_FILTER_FIR)
+#define DECIMATE_FILTER DECIM_FILTER_FIR
+#else
+#define DECIMATE_FILTER DECIM_FILTER_BOXCAR
+#endif
+
+// Stores 1 min rolling avg. Sizes come from Kconfig in the firmware
+// (CONFIG_CW1_*), host builds get the defaults below.
+#ifdef CONFIG_CW1_AVG_WINDOW_SAMPLES
+#define AVG_WINDOW_SAMPLES CONFIG_CW1_AVG_WINDOW_SAMPLES
+#else
+#define AVG_WINDOW_SAMPLES 60
+#endif
+
+#ifdef CONFIG_CW1_DRIFT_UPDATE_SAMPLES
+#define DRIFT_UPDATE_SAMPLES CONFIG_CW1_DRIFT_UPDATE_SAMPLES
+#else
+#define DRIFT_UPDATE_SAMPLES 600  // 24 hours 
+#endif
+
+// power-of-two windows wrap the index with a mask
+#define AVG_WINDOW_POW2 ((AVG_WINDOW_SAMPLES & (AVG_WINDOW_SAMPLES - 1)) == 0)
+
+#define DRIFT_THRESHOLD_CENTI 200   // 2.00C
+#define STABLE_BAND_CENTI 400       // 4.00C
+#define DRIFT_REF_MIN_UPDATES 1440  // REFERNCE VALID AFTER 24 HRS
+
+typedef struct {
+    int16_t buffer[AVG_WINDOW_SAMPLES];
+    int32_t sum_centi;
+    decim_filter_t decimate;
+    uint16_t index;
+    uint16_t valid_samples;
+} temp_avg_t; 
+
+// Everything process_sample() updates for one sensor
+typedef struct {
+    system_state_t system_state;
+    int16_t latest_temp_centi;
+    int32_t latest_mv;
+    int16_t avg_temp_centi;
+    int16_t warning_threshold_centi;
+
+    temp_avg_t temp_avg;
+
+    bool drift_detected;
+
+    // Welford baseline tracking
+    uint32_t drift_count;
+    int32_t  drift_mean_centi;
+    int64_t  drift_M2;
+
+    // Reference baseline
+    bool     drift_ref_valid;
+    int32_t  drift_ref_centi;
+
+    uint32_t minute_sample_counter;
+} thermal_proc_t;
+
+void thermal_proc_init(thermal_proc_t *p, int16_t threshold_centi);
+
+// Fills temp_centi/valid from a reading already converted to mV (LM335, 10mV/K).
+// Returns 0, or -ERANGE when the reading is outside the sensor range.
+int sample_set_mv(sample_t *s, int32_t mv);
+
+bool environment_is_stable(int16_t avg_centi, int16_t latest_centi);
+void update_drift_welford(thermal_proc_t *p, int16_t stable_avg_centi);
+void process_sample(thermal_proc_t *p, const sample_t *s);
+
+// Next threshold in the button calibration cycle 26 -> 28 -> 30 -> 32C
+int16_t thermal_next_threshold(int16_t threshold_centi);
+
+// More severe of two states (NORMAL < WARNING < DRIFT < FAULT), used to
+// summarise several sensors in one state
+system_state_t state_worst(system_state_t a, system_state_t b);
+
+#endif /* CW1_PROCESSING_H */
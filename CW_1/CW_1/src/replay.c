@@ -0,0 +1,78 @@
+/* Trace replay for native_sim, see replay.h
+ *
+ * The trace is a little-endian stream of {int16 mv, uint16 repeat} runs
+ * (tools/make_trace.py) embedded at build time. Each ADC sampling takes the
+ * next reading; once the trace is used up the last reading is held.
+ */
+#if defined(CW1_REPLAY)
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "replay.h"
+
+static const uint8_t replay_trace[] = {
+#include "replay_trace.inc"
+};
+
+#define REPLAY_RUN_SIZE 4
+
+BUILD_ASSERT(sizeof(replay_trace) % REPLAY_RUN_SIZE == 0,
+             "replay trace must be whole {mv, repeat} runs");
+
+static size_t   run_offset;     // byte offset of the current run
+static uint16_t run_used;       // samples taken from the current run
+static uint32_t position;
+static bool     finished;
+
+static int replay_value(const struct device *dev, unsigned int chan,
+                        void *data, uint32_t *result)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(chan);
+    ARG_UNUSED(data);
+
+    int16_t  mv     = (int16_t)sys_get_le16(&replay_trace[run_offset]);
+    uint16_t repeat = sys_get_le16(&replay_trace[run_offset + 2]);
+
+    *result = (mv < 0) ? 0 : (uint32_t)mv;
+
+    if (finished) {
+        return 0;
+    }
+
+    position++;
+    run_used++;
+
+    if (run_used >= repeat) {
+        run_used = 0;
+        if (run_offset + REPLAY_RUN_SIZE < sizeof(replay_trace)) {
+            run_offset += REPLAY_RUN_SIZE;
+        } else {
+            finished = true;
+        }
+    }
+
+    return 0;
+}
+
+int replay_attach(const struct device *adc_dev, uint8_t channel_id)
+{
+    printk("Replay: %u runs loaded\n", (unsigned int)(sizeof(replay_trace) / REPLAY_RUN_SIZE));
+
+    return adc_emul_value_func_set(adc_dev, channel_id, replay_value, NULL);
+}
+
+bool replay_finished(void)
+{
+    return finished;
+}
+
+uint32_t replay_position(void)
+{
+    return position;
+}
+
+#endif /* CW1_REPLAY */
@@ -0,0 +1,20 @@
+/* Trace replay for native_sim - the emulated ADC returns recorded readings
+ * instead of a constant. Built when CMake is given -DREPLAY_TRACE=<file>.
+ */
+#ifndef CW1_REPLAY_H
+#define CW1_REPLAY_H
+
+#include <zephyr/device.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Feeds the trace into the emulated ADC channel
+int replay_attach(const struct device *adc_dev, uint8_t channel_id);
+
+// True once every trace sample has been handed to the ADC
+bool replay_finished(void);
+
+// Trace samples handed out so far
+uint32_t replay_position(void);
+
+#endif /* CW1_REPLAY_H */
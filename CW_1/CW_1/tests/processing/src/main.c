@@ -0,0 +1,200 @@
+/* Unit tests for the CW_1 processing library (src/processing.c)
+ *
+ *     west twister -T CW_1/CW_1/tests/processing
+ *
+ * Runs on unit_testing with the firmware defaults (DECIMATE_FACTOR 10,
+ * boxcar filter); testcase.yaml builds it once with the default 60 entry
+ * window and once with a power-of-two window, which wraps with a mask.
+ */
+#include <zephyr/ztest.h>
+
+#include <errno.h>
+
+#include "processing.h"
+
+static thermal_proc_t proc;
+
+static sample_t sample_centi(int16_t temp_centi)
+{
+    sample_t s = {
+        .mv = (temp_centi + 27315) / 10,
+        .temp_centi = temp_centi,
+        .valid = true,
+    };
+
+    return s;
+}
+
+static void feed(int16_t temp_centi, uint32_t n)
+{
+    sample_t s = sample_centi(temp_centi);
+
+    for (uint32_t i = 0; i < n; i++) {
+        process_sample(&proc, &s);
+    }
+}
+
+static void processing_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    thermal_proc_init(&proc, DEFAULT_TEMP_THRESHOLD_CENTI);
+}
+
+ZTEST_SUITE(processing, NULL, NULL, processing_before, NULL, NULL);
+
+ZTEST(processing, test_sample_set_mv)
+{
+    sample_t s;
+
+    zassert_equal(sample_set_mv(&s, 2982), 0);
+    zassert_true(s.valid);
+    zassert_equal(s.temp_centi, 2505, "2982 mV is 25.05C on an LM335");
+
+    zassert_equal(sample_set_mv(&s, -1), -ERANGE);
+    zassert_false(s.valid);
+    zassert_equal(sample_set_mv(&s, 2000), -ERANGE, "below -40C");
+    zassert_equal(sample_set_mv(&s, 3800), -ERANGE, "above 100C");
+}
+
+ZTEST(processing, test_decimation)
+{
+    int32_t sum = 0;
+
+    if (DECIMATE_FILTER != DECIM_FILTER_BOXCAR) {
+        ztest_test_skip();
+    }
+
+    for (int i = 0; i < DECIMATE_FACTOR - 1; i++) {
+        feed(2500 + i, 1);
+        sum += 2500 + i;
+        zassert_equal(proc.temp_avg.valid_samples, 0, "no output before DECIMATE_FACTOR inputs");
+    }
+
+    feed(2500 + DECIMATE_FACTOR - 1, 1);
+    sum += 2500 + DECIMATE_FACTOR - 1;
+
+    zassert_equal(proc.temp_avg.valid_samples, 1);
+    zassert_equal(proc.avg_temp_centi, sum / DECIMATE_FACTOR);
+    zassert_equal(proc.latest_temp_centi, 2500 + DECIMATE_FACTOR - 1);
+}
+
+ZTEST(processing, test_window_fill_and_wrap)
+{
+    const int32_t w = AVG_WINDOW_SAMPLES;
+
+    // the step below only lands in one window entry with the boxcar
+    if (DECIMATE_FILTER != DECIM_FILTER_BOXCAR) {
+        ztest_test_skip();
+    }
+
+    feed(2000, w * DECIMATE_FACTOR);
+    zassert_equal(proc.temp_avg.valid_samples, w);
+    zassert_equal(proc.temp_avg.index, 0, "index wraps after a full window");
+    zassert_equal(proc.temp_avg.sum_centi, w * 2000);
+    zassert_equal(proc.avg_temp_centi, 2000);
+
+    // the oldest entry is replaced, the window stays full
+    feed(3000, DECIMATE_FACTOR);
+    zassert_equal(proc.temp_avg.valid_samples, w);
+    zassert_equal(proc.temp_avg.index, 1 % w);
+    zassert_equal(proc.temp_avg.sum_centi, (w - 1) * 2000 + 3000);
+    zassert_equal(proc.avg_temp_centi, ((w - 1) * 2000 + 3000) / w);
+
+    feed(3000, (w - 1) * DECIMATE_FACTOR);
+    zassert_equal(proc.temp_avg.index, 0);
+    zassert_equal(proc.avg_temp_centi, 3000);
+}
+
+ZTEST(processing, test_welford_mean_m2)
+{
+    update_drift_welford(&proc, 2400);
+    zassert_equal(proc.drift_count, 1);
+    zassert_equal(proc.drift_mean_centi, 2400);
+    zassert_equal(proc.drift_M2, 0);
+
+    update_drift_welford(&proc, 2600);
+    zassert_equal(proc.drift_count, 2);
+    zassert_equal(proc.drift_mean_centi, 2500);
+    zassert_equal(proc.drift_M2, 200 * 100, "M2 += (x - old mean) * (x - new mean)");
+}
+
+ZTEST(processing, test_drift_reference_and_detection)
+{
+    int updates = 0;
+
+    for (int i = 0; i < DRIFT_REF_MIN_UPDATES - 1; i++) {
+        update_drift_welford(&proc, 2500);
+    }
+    zassert_false(proc.drift_ref_valid, "no reference before DRIFT_REF_MIN_UPDATES");
+
+    update_drift_welford(&proc, 2500);
+    zassert_true(proc.drift_ref_valid);
+    zassert_equal(proc.drift_ref_centi, 2500);
+    zassert_false(proc.drift_detected);
+
+    // integer Welford: the mean only moves when delta > count
+    while (!proc.drift_detected && updates < 200) {
+        update_drift_welford(&proc, 10000);
+        updates++;
+    }
+    zassert_true(proc.drift_detected, "mean moved %d from the reference",
+                 proc.drift_mean_centi - 2500);
+    zassert_true(proc.drift_mean_centi - 2500 > DRIFT_THRESHOLD_CENTI);
+
+    feed(2500, 1);
+    zassert_equal(proc.system_state, STATE_DRIFT);
+}
+
+ZTEST(processing, test_drift_update_cadence)
+{
+    feed(2500, DRIFT_UPDATE_SAMPLES - 1);
+    zassert_equal(proc.drift_count, 0);
+
+    feed(2500, 1);
+    zassert_equal(proc.drift_count, 1, "one update every DRIFT_UPDATE_SAMPLES");
+    zassert_equal(proc.drift_mean_centi, proc.avg_temp_centi);
+
+    // a reading outside STABLE_BAND_CENTI of the average skips the update
+    feed(2500, DRIFT_UPDATE_SAMPLES - 1);
+    feed(2500 + STABLE_BAND_CENTI + 1, 1);
+    zassert_equal(proc.drift_count, 1);
+}
+
+ZTEST(processing, test_state_thresholds)
+{
+    sample_t bad = { .valid = false };
+
+    feed(DEFAULT_TEMP_THRESHOLD_CENTI, AVG_WINDOW_SAMPLES * DECIMATE_FACTOR);
+    zassert_equal(proc.avg_temp_centi, DEFAULT_TEMP_THRESHOLD_CENTI);
+    zassert_equal(proc.system_state, STATE_NORMAL, "the threshold itself is NORMAL");
+
+    thermal_proc_init(&proc, DEFAULT_TEMP_THRESHOLD_CENTI);
+    feed(DEFAULT_TEMP_THRESHOLD_CENTI + 1, AVG_WINDOW_SAMPLES * DECIMATE_FACTOR);
+    zassert_equal(proc.system_state, STATE_WARNING);
+
+    process_sample(&proc, &bad);
+    zassert_equal(proc.system_state, STATE_FAULT);
+    zassert_equal(proc.avg_temp_centi, DEFAULT_TEMP_THRESHOLD_CENTI + 1,
+                  "a FAULT sample leaves the average alone");
+
+    feed(DEFAULT_TEMP_THRESHOLD_CENTI + 1, 1);
+    zassert_equal(proc.system_state, STATE_WARNING, "the next valid sample recovers");
+
+    proc.warning_threshold_centi = thermal_next_threshold(proc.warning_threshold_centi);
+    feed(DEFAULT_TEMP_THRESHOLD_CENTI + 1, 1);
+    zassert_equal(proc.system_state, STATE_NORMAL);
+}
+
+ZTEST(processing, test_threshold_cycle_and_worst)
+{
+    zassert_equal(thermal_next_threshold(2600), 2800);
+    zassert_equal(thermal_next_threshold(2800), 3000);
+    zassert_equal(thermal_next_threshold(3000), 3200);
+    zassert_equal(thermal_next_threshold(3200), 2600);
+    zassert_equal(thermal_next_threshold(1234), 2600);
+
+    zassert_equal(state_worst(STATE_NORMAL, STATE_WARNING), STATE_WARNING);
+    zassert_equal(state_worst(STATE_DRIFT, STATE_WARNING), STATE_DRIFT);
+    zassert_equal(state_worst(STATE_DRIFT, STATE_FAULT), STATE_FAULT);
+    zassert_equal(state_worst(STATE_FAULT, STATE_NORMAL), STATE_FAULT);
+}
@@ -0,0 +1,154 @@
+/* Host benchmark for the CW_1 decimation filters (src/filter.c)
+ *
+ *     cc -O2 -Isrc tools/filter_bench.c tools/filter_bench_wide.c \
+ *        src/filter.c -lm -o filter_bench
+ *     ./filter_bench [samples]
+ *
+ * Runs every filter over the same synthetic 10 Hz input and prints the time
+ * per input sample (and TSC cycles on x86), the RMS output error for white
+ * noise and the residual of a 3.3 Hz tone, which should be rejected before
+ * decimating to 1 Hz. The input is 25.00C, in centi-degrees like
+ * process_sample().
+ *
+ * The CIC is also run at a decimation of 100 (tools/filter_bench_wide.c),
+ * where it needs 64-bit integrators. Exits 1 if any filter's noise error is
+ * above the input noise, as wrapped integrators give errors of degrees.
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "filter.h"
+
+// tools/filter_bench_wide.c
+int wide_cic_factor(void);
+double wide_cic_rms(const int16_t *in, size_t n, int16_t level);
+
+#define LEVEL_CENTI   2500
+#define NOISE_CENTI   50      // RMS of the white noise
+#define TONE_CENTI    100     // amplitude of the out-of-band tone
+#define TONE_HZ       3.3
+#define SAMPLE_HZ     10.0
+
+static uint32_t rng = 12345;
+
+// xorshift32 + Box-Muller, reproducible across runs
+static double gauss(void)
+{
+    double u[2];
+
+    for (int i = 0; i < 2; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        u[i] = (rng + 1.0) / 4294967297.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// RMS of (output - LEVEL_CENTI) over the whole input
+static double rms_error(decim_filter_type_t type, const int16_t *in, size_t n)
+{
+    decim_filter_t f;
+    double sum = 0.0;
+    size_t outputs = 0;
+    int16_t out;
+
+    decim_filter_init(&f, type);
+    for (size_t i = 0; i < n; i++) {
+        if (decim_filter_push(&f, in[i], &out)) {
+            sum += (double)(out - LEVEL_CENTI) * (out - LEVEL_CENTI);
+            outputs++;
+        }
+    }
+    return outputs ? sqrt(sum / outputs) : 0.0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000000;
+    int16_t *noise = malloc(n * sizeof(*noise));
+    int16_t *tone = malloc(n * sizeof(*tone));
+
+    if (noise == NULL || tone == NULL || n == 0) {
+        fprintf(stderr, "cannot allocate %zu samples\n", n);
+        return 1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        noise[i] = (int16_t)lround(LEVEL_CENTI + NOISE_CENTI * gauss());
+        tone[i] = (int16_t)lround(LEVEL_CENTI +
+                                  TONE_CENTI * sin(2.0 * M_PI * TONE_HZ * i / SAMPLE_HZ));
+    }
+
+    printf("%zu samples, decimation %d, noise %d centi RMS, %.1f Hz tone %d centi\n\n",
+           n, DECIMATE_FACTOR, NOISE_CENTI, TONE_HZ, TONE_CENTI);
+    printf("%-8s %10s %12s %12s %12s\n", "filter", "ns/sample", "cycles/smp",
+           "noise RMS", "tone RMS");
+
+    int failed = 0;
+
+    for (int type = 0; type < DECIM_FILTER_COUNT; type++) {
+        decim_filter_t f;
+        volatile int32_t sink = 0;
+        int16_t out;
+
+        decim_filter_init(&f, type);
+
+        double t0 = now_ns();
+#if HAVE_TSC
+        uint64_t c0 = __rdtsc();
+#endif
+        for (size_t i = 0; i < n; i++) {
+            if (decim_filter_push(&f, noise[i], &out)) {
+                sink += out;
+            }
+        }
+#if HAVE_TSC
+        double cycles = (double)(__rdtsc() - c0) / n;
+#else
+        double cycles = 0.0;
+#endif
+        double ns = (now_ns() - t0) / n;
+
+        double noise_rms = rms_error(type, noise, n);
+
+        printf("%-8s %10.2f %12.1f %12.2f %12.2f\n", decim_filter_name(type), ns, cycles,
+               noise_rms, rms_error(type, tone, n));
+        failed |= noise_rms > NOISE_CENTI;
+        (void)sink;
+    }
+
+    // time includes the error sums, which only run once per output
+    double t0 = now_ns();
+    double wide_noise = wide_cic_rms(noise, n, LEVEL_CENTI);
+    double ns = (now_ns() - t0) / n;
+    char name[16];
+
+    snprintf(name, sizeof(name), "cic/%d", wide_cic_factor());
+    printf("%-8s %10.2f %12s %12.2f %12.2f\n", name, ns, "-",
+           wide_noise, wide_cic_rms(tone, n, LEVEL_CENTI));
+    failed |= wide_noise > NOISE_CENTI;
+
+    if (failed) {
+        printf("\nFAIL: a filter's noise error is above the input noise\n");
+    }
+
+    free(noise);
+    free(tone);
+    return failed;
+}
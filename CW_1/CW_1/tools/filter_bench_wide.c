@@ -0,0 +1,36 @@
+/* src/filter.c built a second time at a large decimation, so filter_bench
+ * also runs the 64-bit CIC integrators (DECIMATE_FACTOR > CIC_R_MAX_32),
+ * which the default build never reaches. The public names are renamed so
+ * both copies link into one binary.
+ */
+#define DECIMATE_FACTOR   100
+#define decim_filter_init wide_filter_init
+#define decim_filter_push wide_filter_push
+#define decim_filter_name wide_filter_name
+
+#include "filter.c"
+
+#include <math.h>
+
+int wide_cic_factor(void)
+{
+    return DECIMATE_FACTOR;
+}
+
+// RMS of (output - level) of the CIC at DECIMATE_FACTOR over the input
+double wide_cic_rms(const int16_t *in, size_t n, int16_t level)
+{
+    decim_filter_t f;
+    double sum = 0.0;
+    size_t outputs = 0;
+    int16_t out;
+
+    decim_filter_init(&f, DECIM_FILTER_CIC);
+    for (size_t i = 0; i < n; i++) {
+        if (decim_filter_push(&f, in[i], &out)) {
+            sum += (double)(out - level) * (out - level);
+            outputs++;
+        }
+    }
+    return outputs ? sqrt(sum / outputs) : 0.0;
+}
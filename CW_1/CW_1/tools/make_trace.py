@@ -0,0 +1,87 @@
+"""Builds replay traces for the CW_1 native_sim replay mode.
+
+A trace is a little-endian stream of {int16 mv, uint16 repeat} runs, one
+ADC sampling per repeat (SAMPLE_PERIOD_MS apart on the device). Runs keep
+long recordings small enough to embed in the firmware.
+
+    # recorded readings, one mV (or raw, with --raw) value per line
+    python make_trace.py --csv capture.csv -o trace.bin
+
+    # synthetic 24 h drift scenario at 10 Hz
+    python make_trace.py --drift --hours 48 -o drift.bin
+"""
+import argparse
+import struct
+
+SAMPLE_RATE_HZ = 10
+KELVIN_MV = 2731.5  # LM335 at 0C, 10mV/K
+
+
+def celsius_to_mv(temp_c):
+    return int(round(KELVIN_MV + temp_c * 10))
+
+
+def runs_from_values(values):
+    """Collapses consecutive identical readings into {mv, repeat} runs"""
+    runs = []
+    for mv in values:
+        if runs and runs[-1][0] == mv and runs[-1][1] < 0xFFFF:
+            runs[-1][1] += 1
+        else:
+            runs.append([mv, 1])
+    return runs
+
+
+def drift_scenario(hours, base_c, drift_c_per_day, step_s):
+    """Stable room temperature with a slow sensor drift after the first day.
+
+    The temperature is held for step_s seconds at a time, so the whole
+    scenario is a few thousand runs rather than a million samples.
+    """
+    samples_per_step = int(step_s * SAMPLE_RATE_HZ)
+    steps = int(hours * 3600 / step_s)
+    values = []
+    for step in range(steps):
+        t_h = step * step_s / 3600.0
+        drift = 0.0 if t_h < 24 else (t_h - 24) / 24.0 * drift_c_per_day
+        values.append((celsius_to_mv(base_c + drift), samples_per_step))
+    return [[mv, n] for mv, n in values]
+
+
+def write_trace(path, runs):
+    with open(path, "wb") as f:
+        for mv, repeat in runs:
+            while repeat > 0:
+                chunk = min(repeat, 0xFFFF)
+                f.write(struct.pack("<hH", mv, chunk))
+                repeat -= chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a CW_1 replay trace")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--csv", help="one reading per line (mV)")
+    parser.add_argument("--drift", action="store_true", help="synthetic drift scenario")
+    parser.add_argument("--hours", type=float, default=48)
+    parser.add_argument("--base", type=float, default=22.0, help="room temperature in C")
+    parser.add_argument("--drift-per-day", type=float, default=3.0, help="sensor drift in C/day")
+    parser.add_argument("--step", type=float, default=60.0, help="seconds per temperature step")
+    args = parser.parse_args()
+
+    if args.csv:
+        with open(args.csv) as f:
+            values = [int(float(line.split(",")[0])) for line in f if line.strip()]
+        runs = runs_from_values(values)
+    elif args.drift:
+        runs = drift_scenario(args.hours, args.base, args.drift_per_day, args.step)
+    else:
+        parser.error("give --csv or --drift")
+
+    write_trace(args.output, runs)
+    samples = sum(n for _, n in runs)
+    print(f"{args.output}: {len(runs)} runs, {samples} samples "
+          f"({samples / SAMPLE_RATE_HZ / 3600:.1f} h at {SAMPLE_RATE_HZ} Hz)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,91 @@
+/* Host benchmark for the CW_1 processing pipeline (src/processing.c)
+ *
+ *     cc -O2 -Isrc tools/processing_bench.c src/processing.c src/filter.c \
+ *        -o processing_bench
+ *     ./processing_bench [samples]
+ *
+ * Runs process_sample() over a synthetic 25C trace with noise and a slow
+ * drift, once per decimation filter, and prints the time per sample (and TSC
+ * cycles on x86). That covers the decimation, rolling average, Welford
+ * update and state decision the logic thread runs for every sample. The
+ * unit tests for the same code are in tests/processing.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "processing.h"
+
+static uint32_t rng = 12345;
+
+// xorshift32, uniform in -range..range
+static int16_t noise(int16_t range)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (int16_t)((int32_t)(rng % (2U * range + 1)) - range);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000000;
+    sample_t *trace = malloc(n * sizeof(*trace));
+
+    if (trace == NULL || n == 0) {
+        fprintf(stderr, "cannot allocate %zu samples\n", n);
+        return 1;
+    }
+
+    // 25C, +-0.5C noise, 3C of drift over the trace
+    for (size_t i = 0; i < n; i++) {
+        int16_t t = (int16_t)(2500 + (int32_t)(300.0 * i / n) + noise(50));
+
+        sample_set_mv(&trace[i], (t + 27315) / 10);
+    }
+
+    printf("%zu samples, decimation %d, window %d, drift update every %d\n\n",
+           n, DECIMATE_FACTOR, AVG_WINDOW_SAMPLES, DRIFT_UPDATE_SAMPLES);
+    printf("%-8s %10s %12s %8s\n", "filter", "ns/sample", "cycles/smp", "state");
+
+    for (int type = 0; type < DECIM_FILTER_COUNT; type++) {
+        static thermal_proc_t proc;
+
+        thermal_proc_init(&proc, DEFAULT_TEMP_THRESHOLD_CENTI);
+        decim_filter_init(&proc.temp_avg.decimate, type);
+
+        double t0 = now_ns();
+#if HAVE_TSC
+        uint64_t c0 = __rdtsc();
+#endif
+        for (size_t i = 0; i < n; i++) {
+            process_sample(&proc, &trace[i]);
+        }
+#if HAVE_TSC
+        double cycles = (double)(__rdtsc() - c0) / n;
+#else
+        double cycles = 0.0;
+#endif
+        double ns = (now_ns() - t0) / n;
+
+        // the final state keeps the loop from being optimised away
+        printf("%-8s %10.2f %12.1f %8d\n", decim_filter_name(type), ns, cycles,
+               (int)proc.system_state);
+    }
+
+    free(trace);
+    return 0;
+}
@@ -0,0 +1,188 @@
+"""Host decoder for the CW_1 binary status record.
+
+The board writes one packed status_record per report period straight to the
+console UART (see STATUS_REPORT_BINARY in src/main.c). This tool finds the
+frames in the byte stream, checks the CRC and prints the same status lines
+the firmware used to format itself (one per ADC channel, then a summary).
+Any plain printk text between frames is passed through unchanged.
+
+    python status_decoder.py /dev/ttyACM0          # live from the DK
+    python status_decoder.py --file capture.bin    # from a saved capture
+"""
+import argparse
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+VERSION = 3
+MAX_CHANNELS = 8
+
+# uptime_ms, state, num_channels, thresh, acq_wakeups, logic_wakeups,
+# acq_samples, overruns, led_rate, led_polling_rate, adv_interval_ms,
+# ble_updates, latency_us
+HEADER_FMT = "<IBBhIIIIHHHII"
+HEADER_LEN = struct.calcsize(HEADER_FMT)
+
+# per channel: state, flags, avg, latest, mv, drift_mean, drift_ref
+CHANNEL_FMT = "<BBhhiii"
+CHANNEL_LEN = struct.calcsize(CHANNEL_FMT)
+
+FLAG_DRIFT = 0x01
+FLAG_DRIFT_REF = 0x02
+
+STATES = {0: "NORMAL", 1: "WARNING", 2: "FAULT", 3: "DRIFT"}
+LEDS = {0: "OFF", 1: "BLINKING", 2: "SOLID", 3: "BLINKING"}
+
+
+def crc8(data):
+    """CRC-8, poly 0x07 - matches status_crc8() in the firmware"""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def centi(value):
+    sign = "-" if value < 0 else ""
+    return f"{sign}{abs(value) // 100}.{abs(value) % 100:02d}C"
+
+
+def payload_len(num_channels):
+    return HEADER_LEN + num_channels * CHANNEL_LEN
+
+
+def format_channel(uptime, index, fields):
+    state, flags, avg, latest, mv, drift_mean, drift_ref = fields
+    mode = STATES.get(state, "UNKNOWN")
+
+    if mode == "FAULT":
+        return f"[{uptime} ms] CH{index} Avg: --.-C | Voltage: {mv} mV | Mode: {mode}"
+
+    ref = centi(drift_ref) if flags & FLAG_DRIFT_REF else "0.00C"
+    drift = "YES" if flags & FLAG_DRIFT else "NO"
+    return (f"[{uptime} ms] CH{index} Avg: {centi(avg)} | Latest: {centi(latest)} | "
+            f"Base: {centi(drift_mean)} | Ref: {ref} | Drift: {drift} | Mode: {mode}")
+
+
+def format_record(payload):
+    """Returns the status lines for one record payload (uptime..last channel)"""
+    (uptime, state, num_channels, thresh, acq_wake, logic_wake, acq_n,
+     overruns, led_rate, led_polling, adv_ms, ble_n, latency) = struct.unpack_from(HEADER_FMT, payload)
+
+    lines = []
+    for index in range(num_channels):
+        fields = struct.unpack_from(CHANNEL_FMT, payload, HEADER_LEN + index * CHANNEL_LEN)
+        lines.append(format_channel(uptime, index, fields))
+
+    mode = STATES.get(state, "UNKNOWN")
+    led = LEDS.get(state, "UNKNOWN")
+    lines.append(f"[{uptime} ms] Mode: {mode} | Thresh: {centi(thresh)} | LED: {led} | "
+                 f"Wakeups: acq {acq_wake} logic {logic_wake} / {acq_n} samples | "
+                 f"Overruns: {overruns} | Latency: {latency} us | LED wakeups/min: {led_rate} (polling {led_polling}) | "
+                 f"BLE: {ble_n} updates @ {adv_ms} ms")
+    return lines
+
+
+class Decoder:
+    """Splits a byte stream into status records and printk text"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Returns the lines (decoded records and text) completed by data"""
+        self.buf += data
+        out = []
+
+        while True:
+            idx = self.buf.find(SYNC)
+            if idx < 0:
+                # keep a possible first sync byte for the next read
+                keep = 1 if self.buf.endswith(SYNC[:1]) else 0
+                self._text(self.buf[:len(self.buf) - keep], out)
+                del self.buf[:len(self.buf) - keep]
+                break
+
+            self._text(self.buf[:idx], out)
+            del self.buf[:idx]
+
+            # sync, version, len, payload, crc
+            if len(self.buf) < 4:
+                break
+            version, length = self.buf[2], self.buf[3]
+            # num_channels sits at a fixed offset and has to agree with len
+            if (version != VERSION or length < payload_len(1) or
+                    (length - HEADER_LEN) % CHANNEL_LEN or
+                    (length - HEADER_LEN) // CHANNEL_LEN > MAX_CHANNELS):
+                self._text(self.buf[:1], out)
+                del self.buf[:1]
+                continue
+            frame_len = 4 + length + 1
+            if len(self.buf) < frame_len:
+                break
+
+            frame = bytes(self.buf[:frame_len])
+            if crc8(frame[2:-1]) != frame[-1]:
+                self.crc_errors += 1
+                self._text(self.buf[:1], out)
+                del self.buf[:1]
+                continue
+
+            payload = frame[4:-1]
+            if payload_len(payload[5]) != length:
+                self._text(self.buf[:1], out)
+                del self.buf[:1]
+                continue
+
+            del self.buf[:frame_len]
+            out.extend(format_record(payload))
+
+        return out
+
+    def _text(self, data, out):
+        self.text += data
+        while b"\n" in self.text:
+            line, _, rest = self.text.partition(b"\n")
+            out.append(line.decode("utf-8", errors="replace").rstrip("\r"))
+            self.text = bytearray(rest)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode CW_1 binary status records")
+    parser.add_argument("port", nargs="?", help="serial port of the board")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--file", help="decode a saved capture instead of a serial port")
+    args = parser.parse_args()
+
+    decoder = Decoder()
+
+    if args.file:
+        with open(args.file, "rb") as f:
+            source = iter(lambda: f.read(4096), b"")
+            for chunk in source:
+                for line in decoder.feed(chunk):
+                    print(line)
+    elif args.port:
+        import serial  # pyserial, only needed for live decoding
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            while True:
+                for line in decoder.feed(port.read(256)):
+                    print(line, flush=True)
+    else:
+        for chunk in iter(lambda: sys.stdin.buffer.read(256), b""):
+            for line in decoder.feed(chunk):
+                print(line, flush=True)
+
+    if decoder.crc_errors:
+        print(f"({decoder.crc_errors} frames dropped on CRC)", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
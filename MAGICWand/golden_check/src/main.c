@@ -0,0 +1,50 @@
+/* Runs the golden vectors from MAGICWand/tools/gesture_train.c through the
+ * firmware build of common/gesture and checks that every frame, label and
+ * distance matches the host bit for bit. Prints the cycles per stroke too,
+ * which on the nRF54L15 is the real classification cost.
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#include "gesture.h"
+#include "gesture_model.h"
+#include "gesture_golden.h"
+
+int main(void)
+{
+    int failed = 0;
+    uint32_t worst_cyc = 0, total_cyc = 0;
+
+    printk("Gesture golden check: %u templates, %zu vectors\n",
+           gesture_model.count, ARRAY_SIZE(gesture_golden));
+
+    for (size_t i = 0; i < ARRAY_SIZE(gesture_golden); i++) {
+        const gesture_golden_t *g = &gesture_golden[i];
+        gesture_frame_t frame;
+        uint32_t distance;
+
+        uint32_t start = k_cycle_get_32();
+        gesture_frame_from_points(&gesture_golden_points[g->offset], g->count, &frame);
+        int label = gesture_classify(&gesture_model, &frame, &distance);
+        uint32_t cyc = k_cycle_get_32() - start;
+
+        total_cyc += cyc;
+        worst_cyc = MAX(worst_cyc, cyc);
+
+        bool frame_ok = memcmp(&frame, &g->frame, sizeof(frame)) == 0;
+
+        if (!frame_ok || label != g->label || distance != g->distance) {
+            printk("  vector %zu: FAIL frame %s, label %d (want %d), distance %u (want %u)\n",
+                   i, frame_ok ? "ok" : "differs", label, g->label, distance, g->distance);
+            failed++;
+        }
+    }
+
+    uint32_t avg_cyc = total_cyc / (uint32_t)ARRAY_SIZE(gesture_golden);
+
+    printk("%s: %zu/%zu vectors match, %u cycles avg, %u max (%u us)\n",
+           failed ? "FAIL" : "PASS", ARRAY_SIZE(gesture_golden) - failed,
+           ARRAY_SIZE(gesture_golden), avg_cyc, worst_cyc, k_cyc_to_us_floor32(worst_cyc));
+    return 0;
+}
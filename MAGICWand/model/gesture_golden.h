@@ -0,0 +1,482 @@
+/* Generated by MAGICWand/tools/gesture_train.c, do not edit
+ *
+ *     gesture_train -o model/gesture_model.h -g model/gesture_golden.h 100_b_strokes_combined.json ../wanddata_combined_preserve_classes.json
+ *
+ * Strokes with the frame, label and distance gesture_model.h gives them.
+ */
+#ifndef GESTURE_GOLDEN_H
+#define GESTURE_GOLDEN_H
+
+#include "gesture.h"
+
+typedef struct {
+    uint16_t        offset;     // first point in gesture_golden_points
+    uint16_t        count;
+    int8_t          label;      // or GESTURE_REJECT
+    uint32_t        distance;
+    gesture_frame_t frame;
+} gesture_golden_t;
+
+static const gesture_point_t gesture_golden_points[] = {
+    { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 },
+    { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 },
+    { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 },
+    { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 }, { 4, -22 },
+    { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 },
+    { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 }, { 4, -24 },
+    { 4, -24 }, { 6, -26 }, { 6, -26 }, { 6, -26 }, { 6, -26 }, { 8, -28 },
+    { 8, -28 }, { 8, -28 }, { 8, -30 }, { 8, -30 }, { 6, -30 }, { 4, -32 },
+    { 0, -32 }, { -2, -32 }, { -4, -30 }, { -8, -30 }, { -10, -30 }, { -10, -28 },
+    { -10, -26 }, { -10, -22 }, { -10, -18 }, { -8, -16 }, { -6, -12 }, { -2, -10 },
+    { 0, -8 }, { 4, -6 }, { 6, -4 }, { 10, -2 }, { 14, 0 }, { 18, 2 },
+    { 20, 4 }, { 24, 4 }, { 28, 4 }, { 30, 2 }, { 34, 2 }, { 38, 0 },
+    { 40, -4 }, { 44, -8 }, { 46, -14 }, { 48, -20 }, { 48, -28 }, { 48, -36 },
+    { 48, -46 }, { 48, -56 }, { 48, -66 }, { 48, -76 }, { 48, -84 }, { 46, -92 },
+    { 44, -96 }, { 40, -98 }, { 34, -96 }, { 28, -90 }, { 22, -82 }, { 14, -74 },
+    { 8, -68 }, { 2, -60 }, { -2, -54 }, { -4, -48 }, { -4, -42 }, { -2, -34 },
+    { -2, -26 }, { 0, -16 }, { -2, -6 }, { -4, 4 }, { -6, 14 }, { -8, 20 },
+    { -10, 26 }, { -12, 30 }, { -14, 34 }, { -16, 36 }, { -16, 38 }, { -18, 40 },
+    { -20, 42 }, { -20, 46 }, { -22, 48 }, { -22, 52 }, { -22, 54 }, { -22, 56 },
+    { -22, 58 }, { -20, 58 }, { -20, 60 }, { -20, 60 }, { -20, 58 }, { -18, 58 },
+    { -18, 56 }, { -18, 56 }, { -18, 56 }, { -18, 56 }, { -18, 56 }, { -20, 58 },
+    { -20, 58 }, { -20, 58 }, { -22, 56 }, { -22, 56 }, { -22, 54 }, { -22, 54 },
+    { -22, 52 }, { -22, 52 }, { -22, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 },
+    { -20, 50 }, { -20, 50 }, { -22, 50 }, { -22, 50 }, { -22, 52 }, { -22, 52 },
+    { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 },
+    { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 }, { -20, 52 },
+    { -20, 52 },
+    { -10, -6 }, { -12, -10 }, { -14, -12 }, { -16, -14 }, { -16, -16 }, { -16, -18 },
+    { -14, -20 }, { -14, -22 }, { -12, -24 }, { -12, -26 }, { -10, -28 }, { -10, -30 },
+    { -8, -34 }, { -8, -38 }, { -6, -42 }, { -4, -48 }, { -2, -56 }, { 0, -62 },
+    { 2, -70 }, { 4, -76 }, { 6, -82 }, { 8, -86 }, { 8, -88 }, { 8, -90 },
+    { 8, -90 }, { 8, -90 }, { 8, -90 }, { 6, -88 }, { 4, -86 }, { 0, -82 },
+    { -4, -80 }, { -8, -76 }, { -14, -72 }, { -18, -66 }, { -20, -60 }, { -22, -52 },
+    { -20, -44 }, { -14, -34 }, { -6, -24 }, { 4, -16 }, { 16, -8 }, { 26, -2 },
+    { 34, -2 }, { 38, -6 }, { 40, -12 }, { 40, -20 }, { 42, -28 }, { 44, -36 },
+    { 50, -42 }, { 56, -50 }, { 60, -58 }, { 64, -66 }, { 66, -74 }, { 66, -82 },
+    { 64, -88 }, { 62, -92 }, { 58, -94 }, { 52, -96 }, { 46, -94 }, { 40, -94 },
+    { 34, -94 }, { 26, -92 }, { 18, -92 }, { 10, -92 }, { 4, -90 }, { -2, -88 },
+    { -8, -84 }, { -10, -78 }, { -12, -72 }, { -14, -64 }, { -14, -56 }, { -14, -46 },
+    { -12, -38 }, { -10, -30 }, { -10, -20 }, { -8, -12 }, { -6, -2 }, { -4, 8 },
+    { -4, 18 }, { -2, 28 }, { -2, 40 }, { -2, 48 }, { -2, 58 }, { -2, 64 },
+    { -2, 70 }, { -2, 76 }, { 0, 78 }, { 0, 82 }, { 0, 82 }, { 0, 84 },
+    { 0, 84 }, { 0, 84 }, { 0, 84 }, { -2, 84 }, { -2, 82 }, { -4, 82 },
+    { -8, 80 }, { -10, 78 }, { -12, 76 }, { -14, 74 }, { -16, 72 }, { -16, 68 },
+    { -18, 66 }, { -20, 62 }, { -20, 60 }, { -20, 56 }, { -20, 54 }, { -20, 50 },
+    { -20, 48 }, { -18, 46 }, { -16, 44 }, { -14, 42 }, { -14, 40 }, { -12, 38 },
+    { -10, 36 }, { -8, 34 }, { -8, 34 }, { -8, 32 }, { -8, 32 }, { -10, 32 },
+    { -10, 32 }, { -10, 32 }, { -10, 32 }, { -10, 32 }, { -10, 32 }, { -10, 34 },
+    { -10, 34 }, { -8, 34 }, { -8, 36 }, { -8, 38 }, { -6, 38 }, { -6, 40 },
+    { -6, 40 }, { -6, 42 }, { -6, 44 }, { -6, 44 }, { -8, 46 }, { -8, 46 },
+    { -8, 46 }, { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 48 },
+    { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 46 }, { -8, 46 }, { -10, 46 },
+    { -10, 44 }, { -10, 44 }, { -8, 44 }, { -8, 42 }, { -8, 42 }, { -8, 42 },
+    { -8, 40 }, { -8, 40 }, { -8, 40 }, { -8, 40 },
+    { 0, 34 }, { 0, 34 }, { 0, 34 }, { 0, 34 }, { 0, 34 }, { 0, 34 },
+    { 0, 34 }, { -2, 34 }, { -2, 34 }, { -2, 34 }, { -2, 34 }, { -2, 34 },
+    { -2, 34 }, { -2, 32 }, { -2, 32 }, { -4, 32 }, { -4, 32 }, { -4, 30 },
+    { -6, 30 }, { -6, 28 }, { -8, 26 }, { -8, 26 }, { -10, 24 }, { -10, 22 },
+    { -10, 20 }, { -10, 18 }, { -10, 16 }, { -10, 14 }, { -10, 12 }, { -10, 10 },
+    { -10, 6 }, { -10, 4 }, { -10, 0 }, { -10, -2 }, { -8, -6 }, { -8, -10 },
+    { -8, -14 }, { -8, -18 }, { -8, -24 }, { -8, -30 }, { -10, -36 }, { -10, -42 },
+    { -10, -50 }, { -12, -56 }, { -12, -62 }, { -12, -66 }, { -14, -70 }, { -14, -72 },
+    { -14, -74 }, { -14, -74 }, { -16, -72 }, { -16, -68 }, { -18, -66 }, { -18, -62 },
+    { -18, -58 }, { -20, -54 }, { -20, -50 }, { -18, -46 }, { -18, -40 }, { -16, -34 },
+    { -16, -28 }, { -14, -22 }, { -12, -16 }, { -10, -12 }, { -6, -8 }, { -4, -4 },
+    { -2, -2 }, { 2, 0 }, { 6, 2 }, { 8, 4 }, { 10, 4 }, { 14, 4 },
+    { 16, 2 }, { 18, 0 }, { 22, -2 }, { 24, -6 }, { 26, -10 }, { 30, -16 },
+    { 32, -22 }, { 32, -30 }, { 34, -36 }, { 34, -42 }, { 34, -48 }, { 32, -54 },
+    { 28, -58 }, { 24, -62 }, { 20, -64 }, { 16, -66 }, { 10, -68 }, { 6, -70 },
+    { 4, -70 }, { 0, -70 }, { -2, -70 }, { -4, -68 }, { -6, -66 }, { -6, -62 },
+    { -6, -58 }, { -6, -52 }, { -6, -46 }, { -6, -40 }, { -6, -34 }, { -4, -28 },
+    { -2, -22 }, { -2, -16 }, { 0, -10 }, { 0, -6 }, { 2, 0 }, { 2, 4 },
+    { 2, 10 }, { 4, 14 }, { 4, 18 }, { 4, 22 }, { 6, 24 }, { 6, 26 },
+    { 6, 28 }, { 6, 30 }, { 6, 32 }, { 6, 32 }, { 6, 34 }, { 6, 36 },
+    { 6, 38 }, { 6, 38 }, { 6, 40 }, { 4, 40 }, { 4, 42 }, { 4, 42 },
+    { 4, 42 }, { 4, 42 }, { 4, 42 }, { 4, 40 }, { 2, 40 }, { 2, 40 },
+    { 2, 40 }, { 2, 40 }, { 2, 40 }, { 2, 40 }, { 2, 40 }, { 2, 38 },
+    { 2, 38 }, { 2, 38 }, { 2, 38 }, { 2, 38 }, { 2, 38 }, { 2, 36 },
+    { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+    { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+    { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+    { -2, 34 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 },
+    { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 },
+    { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 },
+    { -2, 36 }, { -2, 36 }, { -2, 36 }, { -2, 36 }, { -4, 36 }, { -4, 36 },
+    { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 34 },
+    { -4, 32 }, { -4, 30 }, { -4, 30 }, { -4, 26 }, { -6, 24 }, { -6, 20 },
+    { -6, 18 }, { -8, 14 }, { -8, 10 }, { -8, 6 }, { -6, 2 }, { -6, -2 },
+    { -6, -6 }, { -6, -12 }, { -6, -18 }, { -6, -24 }, { -6, -30 }, { -6, -38 },
+    { -8, -44 }, { -10, -50 }, { -12, -54 }, { -14, -58 }, { -16, -62 }, { -18, -64 },
+    { -18, -64 }, { -20, -64 }, { -18, -62 }, { -16, -58 }, { -16, -56 }, { -14, -52 },
+    { -14, -50 }, { -12, -46 }, { -12, -40 }, { -10, -36 }, { -8, -32 }, { -6, -26 },
+    { -4, -22 }, { -2, -18 }, { 2, -16 }, { 4, -14 }, { 6, -12 }, { 8, -12 },
+    { 10, -12 }, { 12, -12 }, { 16, -14 }, { 18, -16 }, { 20, -18 }, { 22, -22 },
+    { 24, -24 }, { 26, -30 }, { 30, -34 }, { 32, -38 }, { 32, -42 }, { 34, -46 },
+    { 34, -50 }, { 32, -54 }, { 30, -58 }, { 26, -60 }, { 22, -62 }, { 18, -64 },
+    { 16, -66 }, { 12, -68 }, { 10, -68 }, { 8, -66 }, { 4, -66 }, { 2, -62 },
+    { -2, -60 }, { -4, -56 }, { -4, -50 }, { -6, -46 }, { -6, -42 }, { -6, -38 },
+    { -6, -32 }, { -6, -28 }, { -6, -22 }, { -6, -18 }, { -4, -14 }, { -4, -8 },
+    { -4, -6 }, { -4, -2 }, { -2, 2 }, { -2, 4 }, { -2, 6 }, { -2, 10 },
+    { 0, 12 }, { 0, 14 }, { 0, 16 }, { 0, 18 }, { 0, 20 }, { 0, 20 },
+    { 2, 22 }, { 0, 24 }, { 0, 26 }, { 0, 26 }, { 0, 26 }, { 0, 28 },
+    { 0, 28 }, { 0, 28 }, { 0, 28 }, { 0, 30 }, { 0, 30 }, { 0, 30 },
+    { 0, 30 }, { 0, 32 }, { 0, 32 }, { 0, 32 }, { 0, 30 }, { 0, 30 },
+    { 0, 30 }, { 0, 30 }, { 0, 30 }, { 0, 30 }, { 0, 30 }, { 0, 30 },
+    { 0, 30 }, { 0, 30 }, { 0, 32 }, { 0, 32 }, { 0, 32 }, { 0, 32 },
+    { 0, 32 }, { 0, 34 }, { 0, 34 }, { 0, 34 }, { 0, 34 }, { 0, 36 },
+    { 0, 36 }, { 0, 36 }, { 0, 38 }, { 0, 38 },
+    { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 },
+    { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 },
+    { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 30 }, { -2, 30 },
+    { -2, 30 }, { -2, 30 }, { -2, 28 }, { -2, 28 }, { 0, 26 }, { 0, 26 },
+    { 0, 24 }, { 0, 22 }, { 0, 20 }, { -2, 18 }, { -2, 14 }, { -2, 12 },
+    { -4, 8 }, { -4, 4 }, { -4, 0 }, { -6, -4 }, { -6, -8 }, { -6, -12 },
+    { -6, -16 }, { -6, -22 }, { -8, -26 }, { -8, -32 }, { -10, -38 }, { -12, -42 },
+    { -16, -46 }, { -18, -50 }, { -20, -54 }, { -22, -56 }, { -22, -56 }, { -24, -54 },
+    { -22, -52 }, { -22, -50 }, { -20, -46 }, { -20, -44 }, { -18, -40 }, { -18, -36 },
+    { -16, -32 }, { -16, -28 }, { -14, -24 }, { -12, -20 }, { -10, -16 }, { -8, -12 },
+    { -6, -8 }, { -4, -4 }, { -2, -2 }, { 0, 0 }, { 2, 2 }, { 4, 4 },
+    { 6, 6 }, { 8, 6 }, { 10, 8 }, { 12, 6 }, { 14, 6 }, { 16, 4 },
+    { 18, 4 }, { 20, 0 }, { 20, -2 }, { 22, -6 }, { 24, -8 }, { 26, -14 },
+    { 28, -18 }, { 28, -22 }, { 30, -26 }, { 30, -32 }, { 28, -36 }, { 28, -40 },
+    { 26, -44 }, { 24, -48 }, { 20, -50 }, { 18, -54 }, { 14, -56 }, { 12, -58 },
+    { 8, -60 }, { 4, -60 }, { 0, -60 }, { -4, -58 }, { -6, -56 }, { -8, -54 },
+    { -10, -52 }, { -12, -48 }, { -12, -46 }, { -12, -42 }, { -14, -38 }, { -14, -34 },
+    { -14, -30 }, { -14, -26 }, { -12, -20 }, { -12, -16 }, { -10, -12 }, { -8, -8 },
+    { -6, -2 }, { -6, 2 }, { -4, 6 }, { -2, 8 }, { -2, 12 }, { 0, 14 },
+    { 0, 16 }, { 0, 18 }, { 2, 20 }, { 2, 20 }, { 2, 22 }, { 2, 22 },
+    { 4, 24 }, { 4, 24 }, { 4, 24 }, { 4, 24 }, { 4, 26 }, { 4, 26 },
+    { 4, 28 }, { 4, 28 }, { 4, 28 }, { 4, 30 }, { 4, 30 }, { 6, 28 },
+    { 6, 28 }, { 6, 28 }, { 4, 28 }, { 4, 28 }, { 4, 28 }, { 4, 28 },
+    { 4, 28 }, { 4, 28 }, { 4, 28 }, { 4, 28 }, { 4, 28 }, { 4, 28 },
+    { 2, 26 }, { 2, 26 }, { 2, 26 }, { 2, 26 }, { 2, 26 }, { 2, 26 },
+    { 2, 26 }, { 2, 26 }, { 2, 28 }, { 2, 28 }, { 2, 28 }, { 2, 28 },
+    { 2, 30 }, { 2, 30 }, { 2, 30 }, { 4, 30 },
+    { -4, 66 }, { -4, 68 }, { -4, 72 }, { -6, 74 }, { -6, 76 }, { -6, 78 },
+    { -6, 80 }, { -6, 82 }, { -6, 84 }, { -6, 86 }, { -6, 88 }, { -6, 88 },
+    { -8, 88 }, { -8, 88 }, { -8, 88 }, { -8, 86 }, { -8, 86 }, { -8, 84 },
+    { -8, 82 }, { -8, 82 }, { -8, 80 }, { -8, 78 }, { -8, 76 }, { -6, 72 },
+    { -6, 68 }, { -6, 64 }, { -4, 60 }, { -4, 54 }, { -2, 48 }, { -2, 42 },
+    { -2, 36 }, { -2, 28 }, { -2, 22 }, { -2, 16 }, { -4, 10 }, { -4, 6 },
+    { -4, 0 }, { -6, -6 }, { -4, -12 }, { -4, -16 }, { -4, -20 }, { -2, -26 },
+    { -2, -32 }, { -2, -38 }, { -2, -42 }, { -4, -46 }, { -6, -50 }, { -6, -52 },
+    { -8, -54 }, { -8, -54 }, { -8, -54 }, { -6, -56 }, { -6, -56 }, { -6, -58 },
+    { -6, -58 }, { -6, -58 }, { -6, -56 }, { -8, -56 }, { -8, -54 }, { -8, -50 },
+    { -8, -46 }, { -8, -40 }, { -8, -34 }, { -6, -26 }, { -6, -20 }, { -4, -12 },
+    { -4, -6 }, { -2, 0 }, { -2, 6 }, { -2, 12 }, { 0, 16 }, { 0, 22 },
+    { 0, 28 }, { 0, 32 }, { 2, 36 }, { 2, 40 }, { 4, 44 }, { 6, 44 },
+    { 6, 44 }, { 8, 42 }, { 10, 40 }, { 12, 36 }, { 12, 34 }, { 16, 30 },
+    { 18, 26 }, { 20, 22 }, { 22, 18 }, { 24, 12 }, { 26, 6 }, { 28, -2 },
+    { 30, -8 }, { 32, -16 }, { 32, -22 }, { 32, -30 }, { 32, -34 }, { 32, -38 },
+    { 30, -42 }, { 28, -44 }, { 26, -46 }, { 24, -48 }, { 22, -50 }, { 20, -52 },
+    { 18, -54 }, { 16, -54 }, { 12, -54 }, { 8, -54 }, { 4, -52 }, { 0, -50 },
+    { -2, -46 }, { -4, -42 }, { -4, -38 }, { -6, -36 }, { -6, -34 }, { -6, -32 },
+    { -8, -30 }, { -8, -28 }, { -8, -26 }, { -8, -26 }, { -8, -24 }, { -8, -24 },
+    { -6, -24 }, { -6, -24 }, { -4, -22 }, { -4, -22 }, { -2, -22 }, { -2, -22 },
+    { -2, -22 }, { -2, -22 }, { -2, -22 }, { -2, -22 }, { -2, -22 }, { -2, -22 },
+    { -2, -22 }, { -2, -20 }, { -2, -20 }, { -2, -20 }, { -2, -20 }, { -4, -18 },
+    { -4, -18 }, { -4, -18 }, { -4, -16 }, { -4, -16 }, { -4, -16 }, { -4, -16 },
+    { -4, -16 }, { -4, -14 }, { -4, -14 }, { -4, -14 }, { -4, -14 }, { -6, -12 },
+    { -6, -12 }, { -6, -10 }, { -6, -10 }, { -6, -8 }, { -6, -8 }, { -6, -8 },
+    { -6, -6 }, { -6, -6 }, { -6, -6 }, { -6, -6 },
+    { -12, -42 }, { -12, -42 }, { -14, -46 }, { -14, -50 }, { -16, -54 }, { -18, -58 },
+    { -20, -62 }, { -20, -64 }, { -20, -66 }, { -20, -68 }, { -20, -70 }, { -20, -70 },
+    { -20, -68 }, { -20, -66 }, { -20, -62 }, { -18, -58 }, { -18, -52 }, { -16, -46 },
+    { -12, -40 }, { -8, -34 }, { -4, -28 }, { 0, -24 }, { 4, -20 }, { 10, -16 },
+    { 16, -14 }, { 20, -12 }, { 26, -12 }, { 30, -12 }, { 32, -14 }, { 34, -16 },
+    { 36, -18 }, { 38, -20 }, { 42, -24 }, { 44, -28 }, { 48, -34 }, { 52, -40 },
+    { 58, -48 }, { 62, -56 }, { 64, -66 }, { 66, -74 }, { 68, -82 }, { 68, -90 },
+    { 68, -96 }, { 66, -104 }, { 66, -108 }, { 64, -114 }, { 62, -116 }, { 56, -118 },
+    { 50, -118 }, { 44, -116 }, { 38, -112 }, { 32, -110 }, { 26, -104 }, { 22, -98 },
+    { 18, -90 }, { 16, -82 }, { 14, -70 }, { 10, -58 }, { 8, -42 }, { 6, -26 },
+    { 2, -10 }, { 0, 6 }, { -2, 18 }, { -4, 30 }, { -6, 40 }, { -6, 48 },
+    { -6, 54 }, { -6, 58 }, { -4, 64 }, { -4, 68 }, { -4, 74 }, { -4, 78 },
+    { -6, 80 }, { -8, 84 }, { -10, 86 }, { -14, 88 }, { -16, 90 }, { -18, 90 },
+    { -20, 92 }, { -20, 92 }, { -22, 94 }, { -22, 94 }, { -22, 94 }, { -22, 92 },
+    { -22, 92 }, { -22, 92 }, { -22, 90 }, { -20, 88 }, { -20, 86 }, { -20, 84 },
+    { -20, 80 }, { -18, 76 }, { -18, 72 }, { -18, 68 }, { -18, 64 }, { -18, 60 },
+    { -18, 56 }, { -18, 52 }, { -18, 48 }, { -18, 44 }, { -18, 42 }, { -18, 38 },
+    { -18, 34 }, { -18, 32 }, { -16, 30 }, { -16, 26 }, { -16, 24 }, { -14, 22 },
+    { -14, 20 }, { -14, 18 }, { -14, 18 }, { -14, 16 }, { -14, 16 }, { -16, 16 },
+    { -16, 16 }, { -16, 18 }, { -16, 18 }, { -14, 18 }, { -14, 20 }, { -14, 22 },
+    { -14, 24 }, { -14, 24 }, { -12, 24 }, { -12, 22 }, { -12, 20 }, { -12, 20 },
+    { -12, 18 }, { -10, 16 }, { -10, 14 }, { -8, 14 }, { -8, 12 }, { -6, 10 },
+    { -6, 10 }, { -4, 8 }, { -4, 8 }, { -2, 8 }, { -2, 6 }, { -2, 6 },
+    { 0, 4 }, { 0, 4 }, { 0, 2 }, { 0, 2 }, { 0, 2 }, { 0, 2 },
+    { -2, 2 }, { -2, 2 }, { -4, 2 }, { -6, 2 }, { -6, 2 }, { -8, 2 },
+    { -8, 2 }, { -10, 2 }, { -10, 2 }, { -10, 2 }, { -10, 4 }, { -10, 4 },
+    { -10, 4 }, { -10, 4 }, { -12, 4 }, { -12, 4 },
+    { -6, -42 }, { -6, -40 }, { -6, -38 }, { -6, -36 }, { -6, -34 }, { -6, -30 },
+    { -6, -28 }, { -6, -26 }, { -4, -24 }, { -4, -20 }, { -4, -18 }, { -4, -16 },
+    { -2, -14 }, { -2, -12 }, { 0, -10 }, { 0, -8 }, { 2, -6 }, { 4, -6 },
+    { 4, -4 }, { 6, -4 }, { 8, -4 }, { 8, -4 }, { 10, -4 }, { 12, -4 },
+    { 14, -6 }, { 16, -6 }, { 18, -8 }, { 20, -10 }, { 22, -12 }, { 26, -14 },
+    { 28, -16 }, { 30, -18 }, { 32, -20 }, { 32, -22 }, { 34, -26 }, { 34, -28 },
+    { 34, -30 }, { 34, -32 }, { 32, -34 }, { 30, -36 }, { 28, -38 }, { 24, -40 },
+    { 18, -40 }, { 14, -40 }, { 10, -42 }, { 8, -44 }, { 6, -46 }, { 4, -48 },
+    { 4, -50 }, { 2, -52 }, { 2, -52 }, { 0, -50 }, { 0, -48 }, { 0, -44 },
+    { 0, -40 }, { 0, -36 }, { 0, -34 }, { 0, -30 }, { 0, -26 }, { 0, -22 },
+    { 0, -16 }, { -2, -12 }, { -2, -6 }, { -4, -2 }, { -4, 4 }, { -6, 8 },
+    { -6, 12 }, { -6, 16 }, { -8, 20 }, { -8, 24 }, { -8, 26 }, { -10, 28 },
+    { -10, 30 }, { -10, 32 }, { -10, 34 }, { -10, 36 }, { -10, 38 }, { -10, 40 },
+    { -10, 44 }, { -10, 46 }, { -10, 48 }, { -12, 50 }, { -12, 52 }, { -12, 54 },
+    { -12, 56 }, { -12, 56 }, { -12, 56 }, { -14, 56 }, { -14, 56 }, { -14, 56 },
+    { -14, 56 }, { -14, 54 }, { -14, 54 }, { -14, 54 }, { -14, 52 }, { -14, 52 },
+    { -14, 50 }, { -16, 50 }, { -16, 48 }, { -16, 46 }, { -16, 46 }, { -16, 44 },
+    { -16, 40 }, { -16, 38 }, { -14, 36 }, { -14, 34 }, { -14, 32 }, { -14, 30 },
+    { -14, 28 }, { -12, 26 }, { -12, 24 }, { -10, 22 }, { -10, 20 }, { -8, 18 },
+    { -8, 16 }, { -8, 14 }, { -8, 12 }, { -6, 10 }, { -6, 8 }, { -6, 6 },
+    { -6, 4 }, { -4, 2 }, { -4, 0 }, { -4, -2 }, { -2, -4 }, { -2, -4 },
+    { -2, -6 }, { 0, -6 }, { 0, -6 }, { 0, -8 }, { 0, -8 }, { 0, -8 },
+    { 0, -10 }, { 0, -10 }, { 0, -10 }, { 0, -12 }, { 2, -12 }, { 2, -12 },
+    { 2, -14 }, { 2, -14 }, { 4, -14 }, { 4, -14 }, { 4, -14 }, { 4, -14 },
+    { 4, -14 }, { 4, -14 }, { 6, -14 }, { 6, -14 }, { 6, -12 }, { 6, -12 },
+    { 6, -12 }, { 6, -12 }, { 6, -12 }, { 6, -12 }, { 6, -12 }, { 6, -12 },
+    { 6, -12 }, { 6, -12 }, { 6, -12 }, { 6, -12 },
+    { 6, -16 }, { 6, -16 }, { 6, -16 }, { 6, -16 }, { 6, -16 }, { 8, -16 },
+    { 8, -16 }, { 8, -16 }, { 8, -16 }, { 8, -16 }, { 10, -18 }, { 10, -18 },
+    { 10, -18 }, { 10, -20 }, { 10, -20 }, { 10, -22 }, { 12, -24 }, { 12, -26 },
+    { 12, -28 }, { 12, -32 }, { 12, -34 }, { 12, -36 }, { 12, -38 }, { 12, -40 },
+    { 10, -42 }, { 10, -42 }, { 10, -44 }, { 8, -44 }, { 8, -44 }, { 6, -44 },
+    { 6, -42 }, { 4, -42 }, { 2, -40 }, { 0, -40 }, { -2, -38 }, { -4, -38 },
+    { -4, -36 }, { -6, -36 }, { -6, -34 }, { -6, -32 }, { -6, -32 }, { -6, -30 },
+    { -6, -28 }, { -6, -26 }, { -4, -26 }, { -4, -24 }, { -2, -22 }, { 0, -22 },
+    { 0, -20 }, { 2, -20 }, { 4, -20 }, { 6, -18 }, { 6, -18 }, { 8, -18 },
+    { 10, -18 }, { 12, -20 }, { 14, -20 }, { 16, -22 }, { 16, -22 }, { 18, -24 },
+    { 20, -24 }, { 22, -26 }, { 24, -26 }, { 26, -28 }, { 28, -30 }, { 30, -32 },
+    { 30, -32 }, { 32, -34 }, { 32, -36 }, { 34, -40 }, { 34, -42 }, { 32, -44 },
+    { 32, -44 }, { 30, -46 }, { 26, -46 }, { 22, -48 }, { 18, -48 }, { 12, -48 },
+    { 10, -48 }, { 6, -48 }, { 6, -48 }, { 4, -48 }, { 4, -48 }, { 4, -48 },
+    { 2, -46 }, { 2, -44 }, { 2, -42 }, { 0, -38 }, { 0, -34 }, { -2, -32 },
+    { -2, -28 }, { -2, -24 }, { -2, -20 }, { -2, -16 }, { -4, -10 }, { -4, -6 },
+    { -4, 0 }, { -6, 4 }, { -8, 8 }, { -8, 14 }, { -10, 18 }, { -10, 22 },
+    { -12, 24 }, { -12, 28 }, { -14, 32 }, { -14, 34 }, { -14, 38 }, { -14, 40 },
+    { -14, 42 }, { -12, 46 }, { -12, 48 }, { -10, 50 }, { -10, 52 }, { -8, 52 },
+    { -8, 54 }, { -8, 54 }, { -8, 56 }, { -10, 56 }, { -10, 56 }, { -12, 56 },
+    { -14, 56 }, { -16, 56 }, { -16, 56 }, { -16, 56 }, { -14, 56 }, { -14, 54 },
+    { -14, 54 }, { -12, 54 }, { -12, 54 }, { -12, 54 }, { -12, 52 }, { -12, 52 },
+    { -12, 52 }, { -12, 52 }, { -12, 50 }, { -12, 50 }, { -12, 50 }, { -12, 50 },
+    { -12, 50 }, { -12, 50 }, { -12, 50 }, { -12, 50 }, { -14, 50 }, { -14, 50 },
+    { -14, 50 }, { -14, 50 }, { -14, 50 }, { -16, 50 }, { -16, 50 }, { -16, 50 },
+    { -16, 50 }, { -18, 48 }, { -18, 48 }, { -18, 48 }, { -20, 48 }, { -20, 48 },
+    { -20, 48 }, { -20, 50 }, { -20, 50 }, { -20, 50 },
+    { -14, -8 }, { -14, -8 }, { -14, -8 }, { -14, -8 }, { -16, -8 }, { -16, -8 },
+    { -16, -8 }, { -16, -8 }, { -16, -8 }, { -16, -8 }, { -16, -8 }, { -16, -8 },
+    { -16, -8 }, { -16, -10 }, { -16, -10 }, { -18, -10 }, { -18, -10 }, { -18, -8 },
+    { -18, -8 }, { -18, -8 }, { -18, -8 }, { -18, -8 }, { -18, -8 }, { -18, -8 },
+    { -16, -8 }, { -16, -8 }, { -14, -8 }, { -14, -8 }, { -12, -6 }, { -12, -6 },
+    { -10, -4 }, { -10, -4 }, { -8, -4 }, { -6, -2 }, { -4, -2 }, { -2, -2 },
+    { 0, 0 }, { 2, 0 }, { 4, 0 }, { 6, 0 }, { 8, 0 }, { 8, 0 },
+    { 10, 0 }, { 12, 0 }, { 14, 0 }, { 16, 0 }, { 18, -2 }, { 18, -2 },
+    { 20, -4 }, { 22, -4 }, { 24, -6 }, { 26, -8 }, { 26, -8 }, { 28, -10 },
+    { 30, -14 }, { 30, -16 }, { 32, -18 }, { 32, -20 }, { 32, -24 }, { 32, -26 },
+    { 30, -28 }, { 30, -30 }, { 28, -32 }, { 28, -34 }, { 26, -36 }, { 26, -38 },
+    { 24, -40 }, { 22, -40 }, { 22, -42 }, { 20, -44 }, { 18, -44 }, { 16, -46 },
+    { 14, -46 }, { 12, -46 }, { 10, -46 }, { 8, -46 }, { 4, -46 }, { 2, -46 },
+    { 2, -46 }, { 0, -46 }, { -2, -44 }, { -2, -44 }, { -4, -44 }, { -4, -42 },
+    { -6, -42 }, { -6, -40 }, { -8, -40 }, { -10, -38 }, { -10, -36 }, { -10, -32 },
+    { -12, -30 }, { -12, -28 }, { -12, -26 }, { -12, -22 }, { -12, -20 }, { -12, -16 },
+    { -10, -12 }, { -10, -10 }, { -10, -6 }, { -10, -2 }, { -8, 0 }, { -8, 4 },
+    { -8, 8 }, { -6, 10 }, { -6, 12 }, { -4, 16 }, { -2, 18 }, { -2, 22 },
+    { 0, 24 }, { 2, 28 }, { 2, 30 }, { 2, 34 }, { 2, 36 }, { 4, 38 },
+    { 4, 38 }, { 4, 38 }, { 4, 38 }, { 4, 38 }, { 4, 38 }, { 4, 38 },
+    { 4, 38 }, { 4, 38 }, { 4, 38 }, { 4, 36 }, { 4, 36 }, { 2, 36 },
+    { 2, 34 }, { 0, 34 }, { 0, 32 }, { 0, 32 }, { 0, 32 }, { -2, 32 },
+    { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -2, 32 }, { -4, 32 },
+    { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 34 }, { -4, 36 },
+    { -4, 36 }, { -4, 36 }, { -4, 36 }, { -4, 36 }, { -4, 36 }, { -4, 36 },
+    { -4, 36 }, { -6, 36 }, { -6, 36 }, { -4, 36 }, { -4, 36 }, { -4, 36 },
+    { -4, 36 }, { -4, 36 },
+    { -10, -12 }, { -10, -12 }, { -10, -12 }, { -10, -12 }, { -10, -12 }, { -10, -12 },
+    { -10, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 },
+    { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 },
+    { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 },
+    { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 },
+    { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -12 }, { -12, -10 }, { -12, -10 },
+    { -12, -10 }, { -12, -10 }, { -12, -10 }, { -10, -8 }, { -8, -8 }, { -4, -10 },
+    { -2, -10 }, { 2, -10 }, { 6, -12 }, { 10, -12 }, { 12, -12 }, { 16, -12 },
+    { 18, -12 }, { 22, -12 }, { 24, -12 }, { 26, -14 }, { 28, -18 }, { 30, -20 },
+    { 32, -24 }, { 34, -28 }, { 36, -32 }, { 36, -36 }, { 36, -42 }, { 36, -46 },
+    { 34, -48 }, { 32, -52 }, { 30, -56 }, { 26, -60 }, { 24, -64 }, { 20, -66 },
+    { 16, -66 }, { 14, -68 }, { 10, -68 }, { 8, -66 }, { 6, -66 }, { 4, -64 },
+    { 2, -62 }, { 2, -60 }, { 0, -56 }, { -2, -54 }, { -2, -50 }, { -2, -46 },
+    { -2, -44 }, { -2, -40 }, { -2, -36 }, { -2, -34 }, { 0, -30 }, { 0, -28 },
+    { 0, -26 }, { 2, -22 }, { 2, -20 }, { 4, -20 }, { 4, -18 }, { 6, -16 },
+    { 8, -16 }, { 10, -14 }, { 12, -12 }, { 14, -8 }, { 14, -6 }, { 14, -4 },
+    { 14, -2 }, { 14, 0 }, { 14, 2 }, { 14, 2 }, { 14, 4 }, { 14, 6 },
+    { 12, 8 }, { 10, 10 }, { 8, 14 }, { 6, 16 }, { 4, 20 }, { 2, 24 },
+    { 0, 26 }, { -2, 30 }, { -4, 34 }, { -6, 36 }, { -6, 38 }, { -6, 38 },
+    { -8, 40 }, { -8, 40 }, { -8, 40 }, { -8, 42 }, { -10, 42 }, { -10, 44 },
+    { -10, 44 }, { -10, 46 }, { -10, 46 }, { -10, 46 }, { -10, 48 }, { -10, 48 },
+    { -8, 48 }, { -8, 48 }, { -8, 50 }, { -8, 50 }, { -8, 48 }, { -8, 48 },
+    { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 48 }, { -8, 46 },
+    { -8, 46 }, { -8, 46 }, { -8, 44 }, { -8, 44 }, { -6, 42 }, { -6, 42 },
+    { -6, 40 }, { -6, 40 }, { -6, 40 }, { -6, 38 }, { -6, 38 }, { -6, 38 },
+    { -6, 38 }, { -6, 38 }, { -6, 38 }, { -6, 38 }, { -6, 38 }, { -6, 38 },
+    { -6, 38 }, { -6, 40 }, { -6, 40 }, { -6, 40 },
+    { -4, 22 }, { -4, 22 }, { -4, 22 }, { -4, 22 }, { -4, 22 }, { -6, 22 },
+    { -6, 22 }, { -6, 22 }, { -6, 22 }, { -6, 22 }, { -6, 20 }, { -6, 20 },
+    { -8, 20 }, { -8, 20 }, { -8, 20 }, { -8, 20 }, { -8, 18 }, { -8, 18 },
+    { -8, 16 }, { -10, 14 }, { -10, 12 }, { -10, 10 }, { -10, 8 }, { -10, 6 },
+    { -12, 4 }, { -12, 4 }, { -12, 2 }, { -12, 2 }, { -12, 0 }, { -12, 0 },
+    { -12, 0 }, { -12, -2 }, { -14, -2 }, { -14, -4 }, { -14, -6 }, { -16, -6 },
+    { -16, -8 }, { -18, -10 }, { -18, -12 }, { -20, -14 }, { -20, -16 }, { -20, -16 },
+    { -20, -18 }, { -20, -20 }, { -20, -22 }, { -22, -24 }, { -22, -26 }, { -22, -28 },
+    { -22, -30 }, { -22, -32 }, { -22, -32 }, { -18, -30 }, { -16, -28 }, { -12, -26 },
+    { -8, -24 }, { -4, -22 }, { 2, -22 }, { 6, -20 }, { 10, -22 }, { 14, -24 },
+    { 20, -26 }, { 24, -28 }, { 28, -32 }, { 32, -34 }, { 36, -38 }, { 40, -42 },
+    { 44, -48 }, { 48, -52 }, { 50, -58 }, { 52, -64 }, { 54, -68 }, { 52, -72 },
+    { 50, -74 }, { 46, -76 }, { 40, -76 }, { 36, -74 }, { 32, -74 }, { 26, -72 },
+    { 22, -70 }, { 16, -68 }, { 12, -66 }, { 6, -62 }, { 2, -60 }, { 0, -56 },
+    { -4, -54 }, { -6, -50 }, { -8, -46 }, { -8, -42 }, { -10, -38 }, { -10, -34 },
+    { -10, -30 }, { -10, -26 }, { -10, -22 }, { -10, -18 }, { -8, -14 }, { -8, -10 },
+    { -8, -6 }, { -8, -2 }, { -8, 0 }, { -6, 4 }, { -6, 6 }, { -6, 10 },
+    { -4, 12 }, { -4, 14 }, { -2, 14 }, { -2, 16 }, { 0, 18 }, { 0, 20 },
+    { 0, 22 }, { 0, 24 }, { -2, 26 }, { -2, 28 }, { -2, 30 }, { 0, 32 },
+    { 0, 34 }, { 0, 34 }, { 0, 36 }, { 0, 36 }, { 0, 36 }, { 0, 36 },
+    { 0, 36 }, { 0, 36 }, { -2, 36 }, { -2, 36 }, { -2, 34 }, { 0, 34 },
+    { 0, 34 }, { 0, 34 }, { 0, 32 }, { 0, 32 }, { 0, 32 }, { 0, 32 },
+    { 0, 32 }, { 0, 32 }, { 2, 32 }, { 2, 32 }, { 2, 32 }, { 2, 34 },
+    { 2, 34 }, { 2, 34 }, { 2, 34 }, { 2, 34 }, { 2, 34 }, { 2, 34 },
+    { 2, 34 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+    { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+    { 2, 36 }, { 2, 36 }, { 2, 36 }, { 2, 36 },
+};
+
+static const gesture_golden_t gesture_golden[12] = {
+    { .offset = 0, .count = 157, .label = 0, .distance = 760,  /* stroke 0 "b" */
+      .frame = { .pt = {
+        {  -13,   -2 }, {  -11,  -16 }, {  -30,  -14 }, {  -35,    3 },
+        {  -22,   17 }, {   -5,   29 }, {   14,   40 }, {   33,   37 },
+        {   48,   24 }, {   56,    5 }, {   57,  -17 }, {   57,  -38 },
+        {   57,  -59 }, {   57,  -79 }, {   57, -102 }, {   49, -121 },
+        {   30, -114 }, {   17,  -98 }, {    3,  -84 }, {  -11,  -68 },
+        {  -24,  -49 }, {  -24,  -29 }, {  -22,   -8 }, {  -21,   13 },
+        {  -24,   33 }, {  -29,   54 }, {  -35,   73 }, {  -44,   92 },
+        {  -54,  110 }, {  -51,  127 }, {  -54,  121 }, {  -51,  116 },
+    } } },
+    { .offset = 157, .count = 160, .label = 0, .distance = 821,  /* stroke 6 "b" */
+      .frame = { .pt = {
+        {  -20,   20 }, {  -23,   -3 }, {  -14,  -28 }, {   -6,  -53 },
+        {    1,  -79 }, {  -13,  -73 }, {  -31,  -53 }, {  -33,  -26 },
+        {  -16,   -5 }, {    5,   13 }, {   28,   25 }, {   43,    8 },
+        {   49,  -19 }, {   65,  -40 }, {   75,  -64 }, {   68,  -89 },
+        {   41,  -91 }, {   15,  -88 }, {  -11,  -83 }, {  -24,  -59 },
+        {  -25,  -33 }, {  -20,   -6 }, {  -16,   20 }, {  -13,   48 },
+        {  -10,   74 }, {  -10,  101 }, {   -8,  127 }, {  -23,  123 },
+        {  -33,   99 }, {  -23,   75 }, {  -15,   77 }, {  -18,   78 },
+    } } },
+    { .offset = 317, .count = 160, .label = 0, .distance = 674,  /* stroke 11 "b" */
+      .frame = { .pt = {
+        {   -2,  118 }, {  -19,  101 }, {  -24,   73 }, {  -24,   43 },
+        {  -19,   13 }, {  -19,  -17 }, {  -24,  -47 }, {  -28,  -77 },
+        {  -32, -108 }, {  -41,  -93 }, {  -45,  -62 }, {  -39,  -32 },
+        {  -32,   -4 }, {  -19,   24 }, {    2,   45 }, {   30,   52 },
+        {   50,   30 }, {   65,    4 }, {   69,  -26 }, {   71,  -58 },
+        {   56,  -82 }, {   28,  -99 }, {    0, -105 }, {  -15,  -84 },
+        {  -15,  -54 }, {  -13,  -24 }, {   -6,    6 }, {    0,   37 },
+        {    2,   67 }, {   11,   97 }, {   11,  127 }, {    2,  123 },
+    } } },
+    { .offset = 477, .count = 160, .label = 0, .distance = 367,  /* stroke 16 "b" */
+      .frame = { .pt = {
+        {   -6,  119 }, {  -11,  106 }, {  -17,   83 }, {  -17,   57 },
+        {  -15,   32 }, {  -15,    6 }, {  -15,  -19 }, {  -19,  -44 },
+        {  -28,  -68 }, {  -42,  -89 }, {  -34,  -70 }, {  -28,  -44 },
+        {  -19,  -21 }, {   -8,    2 }, {    8,   19 }, {   34,   15 },
+        {   49,   -4 }, {   61,  -25 }, {   70,  -51 }, {   64,  -74 },
+        {   40,  -87 }, {   19,  -97 }, {    0,  -83 }, {  -11,  -61 },
+        {  -15,  -38 }, {  -15,  -11 }, {  -13,   13 }, {  -11,   38 },
+        {   -6,   64 }, {   -2,   87 }, {   -2,  110 }, {   -2,  127 },
+    } } },
+    { .offset = 637, .count = 160, .label = 0, .distance = 822,  /* stroke 21 "b" */
+      .frame = { .pt = {
+        {   -3,  127 }, {    3,   98 }, {   -5,   67 }, {  -10,   39 },
+        {  -13,    5 }, {  -18,  -23 }, {  -23,  -54 }, {  -41,  -80 },
+        {  -60,  -96 }, {  -47,  -67 }, {  -39,  -36 }, {  -29,   -8 },
+        {  -13,   21 }, {    5,   47 }, {   29,   65 }, {   52,   47 },
+        {   65,   21 }, {   75,  -10 }, {   80,  -41 }, {   70,  -70 },
+        {   49,  -93 }, {   23, -111 }, {   -8, -106 }, {  -29,  -83 },
+        {  -34,  -52 }, {  -34,  -21 }, {  -26,   10 }, {  -13,   39 },
+        {   -3,   67 }, {    8,   96 }, {   16,  119 }, {   13,  122 },
+    } } },
+    { .offset = 797, .count = 160, .label = -1, .distance = 1537,  /* stroke 26 "b" */
+      .frame = { .pt = {
+        {  -11,  100 }, {  -14,  122 }, {  -17,  127 }, {  -14,  103 },
+        {  -11,   82 }, {   -8,   58 }, {   -8,   34 }, {  -11,   11 },
+        {  -14,  -11 }, {  -11,  -34 }, {   -8,  -58 }, {  -14,  -80 },
+        {  -17,  -91 }, {  -17,  -67 }, {  -14,  -44 }, {  -11,  -20 },
+        {   -8,    3 }, {   -5,   25 }, {   -3,   49 }, {    6,   64 },
+        {   19,   45 }, {   30,   25 }, {   38,    2 }, {   44,  -20 },
+        {   45,  -44 }, {   44,  -67 }, {   27,  -85 }, {    5,  -86 },
+        {  -11,  -71 }, {  -17,  -50 }, {   -8,  -34 }, {  -14,  -13 },
+    } } },
+    { .offset = 957, .count = 160, .label = 0, .distance = 831,  /* stroke 62 "" */
+      .frame = { .pt = {
+        {  -24,  -26 }, {  -32,  -47 }, {  -32,  -47 }, {  -25,  -25 },
+        {  -11,   -7 }, {    7,    6 }, {   29,    3 }, {   42,  -14 },
+        {   56,  -33 }, {   63,  -54 }, {   68,  -77 }, {   65, -100 },
+        {   50, -113 }, {   30, -105 }, {   14,  -89 }, {    7,  -68 },
+        {    1,  -45 }, {   -1,  -23 }, {   -6,    0 }, {   -9,   23 },
+        {  -13,   46 }, {  -17,   69 }, {  -16,   92 }, {  -17,  113 },
+        {  -33,  127 }, {  -32,  110 }, {  -31,   87 }, {  -31,   64 },
+        {  -26,   43 }, {  -24,   46 }, {  -13,   30 }, {  -24,   26 },
+    } } },
+    { .offset = 1117, .count = 160, .label = 0, .distance = 975,  /* stroke 63 "" */
+      .frame = { .pt = {
+        {  -15,  -80 }, {  -15,  -56 }, {  -11,  -34 }, {   -6,  -15 },
+        {    6,    2 }, {   28,   -2 }, {   45,  -15 }, {   62,  -28 },
+        {   71,  -50 }, {   60,  -69 }, {   41,  -75 }, {   17,  -82 },
+        {    4,  -99 }, {   -2,  -84 }, {   -2,  -60 }, {   -2,  -37 },
+        {   -6,  -15 }, {  -11,    6 }, {  -15,   28 }, {  -17,   52 },
+        {  -24,   73 }, {  -24,   95 }, {  -26,  116 }, {  -32,  127 },
+        {  -37,  108 }, {  -32,   86 }, {  -28,   67 }, {  -19,   45 },
+        {  -15,   26 }, {   -9,    4 }, {   -2,  -13 }, {   11,  -15 },
+    } } },
+    { .offset = 1277, .count = 160, .label = 0, .distance = 1005,  /* stroke 64 "" */
+      .frame = { .pt = {
+        {    8,  -14 }, {   16,  -25 }, {   20,  -43 }, {   18,  -63 },
+        {    8,  -64 }, {   -8,  -57 }, {  -16,  -47 }, {  -12,  -31 },
+        {   -2,  -21 }, {   16,  -18 }, {   29,  -27 }, {   45,  -35 },
+        {   59,  -49 }, {   61,  -66 }, {   45,  -74 }, {   27,  -76 },
+        {    8,  -76 }, {    0,  -63 }, {   -6,  -47 }, {   -8,  -29 },
+        {  -10,  -10 }, {  -12,    8 }, {  -16,   25 }, {  -20,   43 },
+        {  -23,   61 }, {  -29,   78 }, {  -31,   96 }, {  -25,  113 },
+        {  -20,  127 }, {  -31,  127 }, {  -29,  115 }, {  -43,  115 },
+    } } },
+    { .offset = 1437, .count = 158, .label = 0, .distance = 1055,  /* stroke 65 "" */
+      .frame = { .pt = {
+        {  -48,    0 }, {  -59,    0 }, {  -40,    8 }, {  -23,   17 },
+        {   -3,   23 }, {   20,   23 }, {   40,   20 }, {   56,    8 },
+        {   73,   -8 }, {   82,  -28 }, {   82,  -51 }, {   71,  -68 },
+        {   62,  -87 }, {   48, -102 }, {   31, -107 }, {    8, -107 },
+        {  -11, -104 }, {  -25,  -93 }, {  -37,  -79 }, {  -42,  -59 },
+        {  -42,  -37 }, {  -40,  -14 }, {  -37,    6 }, {  -31,   25 },
+        {  -28,   48 }, {  -20,   68 }, {  -11,   87 }, {   -3,  104 },
+        {    0,  127 }, {   -3,  119 }, {  -20,  113 }, {  -20,  124 },
+    } } },
+    { .offset = 1595, .count = 160, .label = 0, .distance = 822,  /* stroke 66 "" */
+      .frame = { .pt = {
+        {  -38,    6 }, {  -34,   14 }, {  -18,   10 }, {    0,    6 },
+        {   18,    6 }, {   34,    2 }, {   44,  -12 }, {   50,  -28 },
+        {   54,  -44 }, {   54,  -62 }, {   44,  -79 }, {   34,  -93 },
+        {   20, -103 }, {    4, -107 }, {  -10,  -99 }, {  -18,  -85 },
+        {  -22,  -69 }, {  -22,  -50 }, {  -20,  -32 }, {  -16,  -16 },
+        {   -8,   -4 }, {    6,    6 }, {   10,   24 }, {   10,   40 },
+        {    0,   54 }, {  -10,   71 }, {  -20,   85 }, {  -28,  101 },
+        {  -34,  115 }, {  -36,  127 }, {  -34,  119 }, {  -30,  111 },
+    } } },
+    { .offset = 1755, .count = 160, .label = 0, .distance = 813,  /* stroke 67 "" */
+      .frame = { .pt = {
+        {  -21,   97 }, {  -32,   83 }, {  -36,   61 }, {  -42,   42 },
+        {  -51,   25 }, {  -57,    2 }, {  -57,  -15 }, {  -36,   -4 },
+        {  -15,    4 }, {    6,    4 }, {   30,   -4 }, {   49,  -17 },
+        {   66,  -32 }, {   80,  -51 }, {   93,  -72 }, {  102,  -93 },
+        {   85, -110 }, {   61, -106 }, {   40,  -99 }, {   17,  -91 },
+        {   -2,  -78 }, {  -19,  -64 }, {  -30,  -42 }, {  -34,  -21 },
+        {  -34,    4 }, {  -30,   25 }, {  -30,   51 }, {  -25,   72 },
+        {  -13,   89 }, {  -17,  110 }, {  -17,  125 }, {   -8,  127 },
+    } } },
+};
+
+#endif /* GESTURE_GOLDEN_H */
@@ -0,0 +1,107 @@
+/* Generated by MAGICWand/tools/gesture_train.c, do not edit
+ *
+ *     gesture_train -o model/gesture_model.h -g model/gesture_golden.h 100_b_strokes_combined.json ../wanddata_combined_preserve_classes.json
+ */
+#ifndef GESTURE_MODEL_H
+#define GESTURE_MODEL_H
+
+#include "gesture.h"
+
+#if GESTURE_POINTS != 32 || GESTURE_DTW_BAND != 4
+#error "gesture_model.h was trained for another gesture.h, regenerate it"
+#endif
+
+static const char *const gesture_model_labels[1] = { "b", };
+
+static const gesture_template_t gesture_model_templates[8] = {
+    { .label = 0, .frame = { .pt = {
+        {  -21,   60 }, {  -19,   38 }, {  -15,   23 }, {  -17,    4 },
+        {  -19,  -17 }, {  -17,  -31 }, {  -27,  -31 }, {  -15,  -12 },
+        {    0,    4 }, {   19,   13 }, {   35,    2 }, {   50,  -15 },
+        {   60,  -35 }, {   67,  -56 }, {   64,  -77 }, {   58,  -96 },
+        {   42, -112 }, {   23, -112 }, {   10,  -96 }, {   -2,  -77 },
+        {  -10,  -56 }, {  -13,  -35 }, {  -12,  -13 }, {  -17,   10 },
+        {  -19,   33 }, {  -21,   54 }, {  -21,   75 }, {  -23,   98 },
+        {  -23,  114 }, {  -27,  123 }, {  -33,  127 }, {  -31,  119 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {   34,  -50 }, {   47,  -26 }, {   67,  -11 }, {   95,  -19 },
+        {  114,  -43 }, {  114,  -71 }, {   93,  -97 }, {   60, -105 },
+        {   24, -110 }, {    0, -105 }, {   -9,  -77 }, {  -11,  -41 },
+        {  -13,   -9 }, {  -13,   26 }, {  -17,   58 }, {  -24,   93 },
+        {  -15,  121 }, {  -15,  127 }, {  -19,  105 }, {  -39,   82 },
+        {  -37,   71 }, {  -45,   62 }, {  -39,   56 }, {  -34,   45 },
+        {  -45,   26 }, {  -39,   13 }, {  -39,   -9 }, {  -45,  -26 },
+        {  -39,  -28 }, {  -34,  -26 }, {  -34,  -22 }, {  -34,  -32 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {   10,  127 }, {   12,  126 }, {   10,  124 }, {   13,  123 },
+        {    9,   94 }, {   -1,   64 }, {  -12,   36 }, {  -18,    4 },
+        {  -18,  -28 }, {  -12,  -58 }, {    4,  -85 }, {   33,  -96 },
+        {   49,  -84 }, {   49,  -52 }, {   54,  -21 }, {   60,   10 },
+        {   61,   42 }, {   54,   67 }, {   31,   61 }, {    3,   46 },
+        {  -21,   25 }, {  -34,   -3 }, {  -34,  -34 }, {  -43,  -66 },
+        {  -43,  -88 }, {  -39,  -76 }, {  -31,  -49 }, {  -30,  -52 },
+        {  -30,  -36 }, {  -24,  -36 }, {  -30,  -45 }, {  -31,  -45 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {  -12,  -67 }, {  -27,  -77 }, {  -40,  -95 }, {  -37,  -77 },
+        {  -22,  -47 }, {   -2,  -12 }, {   25,   15 }, {   57,   35 },
+        {   90,   27 }, {  107,   -5 }, {  105,  -37 }, {   75,  -67 },
+        {   42,  -95 }, {   10, -127 }, {    7, -100 }, {    7,  -55 },
+        {    5,  -12 }, {    5,   32 }, {   20,   67 }, {   40,  102 },
+        {   32,  115 }, {  -10,  100 }, {  -50,   80 }, {  -70,   45 },
+        {  -45,   22 }, {  -32,   22 }, {  -42,   25 }, {  -47,   30 },
+        {  -52,   40 }, {  -50,   45 }, {  -55,   47 }, {  -45,   37 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {  -13,  -58 }, {   -9,  -39 }, {   -8,  -24 }, {    9,  -18 },
+        {   29,  -14 }, {   47,  -26 }, {   63,  -45 }, {   67,  -69 },
+        {   54,  -84 }, {   39, -106 }, {   20, -122 }, {   -4, -127 },
+        {  -10, -104 }, {   -6,  -80 }, {   -6,  -55 }, {  -11,  -30 },
+        {  -10,   -5 }, {  -11,   21 }, {  -10,   47 }, {   -4,   72 },
+        {    1,   96 }, {  -10,  109 }, {    4,  101 }, {   -1,   96 },
+        {   -9,   73 }, {  -14,   57 }, {  -26,   52 }, {  -38,   57 },
+        {  -44,   53 }, {  -34,   52 }, {  -26,   53 }, {  -24,   55 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {  -18,   10 }, {  -18,   10 }, {  -15,    7 }, {  -22,  -21 },
+        {  -28,  -50 }, {  -36,  -80 }, {  -44,  -68 }, {  -40,  -37 },
+        {  -29,  -12 }, {  -11,   12 }, {   19,   17 }, {   47,   14 },
+        {   48,  -14 }, {   47,  -44 }, {   48,  -76 }, {   39, -106 },
+        {   15, -124 }, {  -12, -127 }, {  -29, -105 }, {  -18,  -76 },
+        {  -18,  -44 }, {  -14,  -14 }, {   -7,   17 }, {    4,   44 },
+        {   10,   76 }, {    3,  104 }, {   12,  127 }, {   15,  124 },
+        {   14,  110 }, {   11,  109 }, {   12,  105 }, {   12,  109 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {   12,  113 }, {   -7,   99 }, {  -21,   85 }, {  -12,   61 },
+        {  -12,   35 }, {  -12,    9 }, {  -16,  -16 }, {  -16,  -42 },
+        {  -24,  -68 }, {  -38,  -85 }, {  -33,  -64 }, {  -21,  -40 },
+        {   -9,  -16 }, {   12,    0 }, {   35,    5 }, {   54,  -12 },
+        {   64,  -35 }, {   68,  -61 }, {   52,  -80 }, {   28,  -89 },
+        {    5, -101 }, {   -7,  -96 }, {  -14,  -71 }, {  -19,  -47 },
+        {  -19,  -21 }, {  -12,    5 }, {   -7,   31 }, {   -7,   56 },
+        {   -2,   82 }, {    2,  108 }, {    7,  111 }, {   -2,  127 },
+    } } },
+    { .label = 0, .frame = { .pt = {
+        {    7,   48 }, {    7,   71 }, {   11,   98 }, {   11,  127 },
+        {    9,  123 }, {   -5,   95 }, {  -13,   64 }, {   -9,   33 },
+        {   -4,    1 }, {    0,  -31 }, {   -1,  -62 }, {   -2,  -95 },
+        {    6, -126 }, {   31, -121 }, {   32,  -89 }, {   36,  -58 },
+        {   46,  -27 }, {   48,    5 }, {   40,   36 }, {   16,   42 },
+        {   -6,   20 }, {  -26,   -4 }, {  -38,  -34 }, {  -48,  -65 },
+        {  -32,  -68 }, {  -26,  -44 }, {  -20,  -21 }, {  -14,    2 },
+        {  -12,   19 }, {  -12,   24 }, {   -9,   27 }, {  -11,   21 },
+    } } },
+};
+
+static const gesture_model_t gesture_model = {
+    .templates       = gesture_model_templates,
+    .count           = 8,
+    .reject_distance = 1205,
+    .labels          = gesture_model_labels,
+    .label_count     = 1,
+};
+
+#endif /* GESTURE_MODEL_H */
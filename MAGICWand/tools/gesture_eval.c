@@ -0,0 +1,329 @@
+/* Runs the magic wand datasets through common/gesture on the host
+ *
+ *     cc -O2 -I../common/gesture tools/gesture_eval.c tools/wand_json.c \
+ *        tools/wand_data.c ../common/gesture/gesture.c \
+ *        ../common/gesture/stroke_pack.c -lm -o gesture_eval
+ *     ./gesture_eval [-k templates] [-f folds] [-p percentile | -r reject]
+ *                    100_b_strokes_combined.json ../wanddata_combined_preserve_classes.json
+ *
+ * Datasets are JSON or .wpk packs (tools/wand_pack.py). They are merged and exact duplicates dropped (the two files share
+ * most of their strokes), then evaluated with -f fold cross-validation. In
+ * each fold the templates are -k strokes per label spread over the training
+ * strokes, and the reject distance is the -p percentile of the best
+ * distances of the other training strokes (or fixed with -r). Unlabeled
+ * strokes are the reject class: never trained on, expected to be rejected.
+ *
+ * Prints the accuracy per class and the time and TSC cycles per stroke for
+ * the frame preparation and the classification, and the worst-case DTW
+ * cell count, which is what bounds the time on the device.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "gesture.h"
+#include "wand_json.h"
+
+#define MAX_LABELS 16
+
+static char label_names[MAX_LABELS][WAND_LABEL_MAX];
+static const char *label_ptrs[MAX_LABELS];
+static int label_count;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint64_t cycles(void)
+{
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Label index, added on first use; GESTURE_REJECT for ""
+static int label_index(const char *label, bool add)
+{
+    if (label[0] == '\0') {
+        return GESTURE_REJECT;
+    }
+    for (int i = 0; i < label_count; i++) {
+        if (strcmp(label_names[i], label) == 0) {
+            return i;
+        }
+    }
+    if (!add || label_count == MAX_LABELS) {
+        return GESTURE_REJECT;
+    }
+    snprintf(label_names[label_count], WAND_LABEL_MAX, "%s", label);
+    label_ptrs[label_count] = label_names[label_count];
+    return label_count++;
+}
+
+static bool same_stroke(const wand_stroke_t *a, const wand_stroke_t *b)
+{
+    return a->n == b->n && memcmp(a->pts, b->pts, a->n * sizeof(*a->pts)) == 0 &&
+           strcmp(a->label, b->label) == 0;
+}
+
+// Appends the strokes of ds to the pool, skipping exact duplicates (the
+// wand datasets share strokes)
+static size_t add_unique(const wand_stroke_t **pool, size_t count, const wand_dataset_t *ds)
+{
+    for (size_t i = 0; i < ds->count; i++) {
+        size_t j = 0;
+
+        while (j < count && !same_stroke(pool[j], &ds->strokes[i])) {
+            j++;
+        }
+        if (j == count) {
+            pool[count++] = &ds->strokes[i];
+            label_index(ds->strokes[i].label, true);
+        }
+    }
+    return count;
+}
+
+// Picks k templates per label out of the train strokes, evenly spread
+static uint16_t pick_templates(const wand_stroke_t **train, size_t count, int k,
+                               gesture_template_t *t, bool *is_template)
+{
+    uint16_t picked_total = 0;
+
+    for (int l = 0; l < label_count; l++) {
+        size_t members = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            members += label_index(train[i]->label, false) == l;
+        }
+
+        size_t seen = 0;
+        int picked = 0;
+
+        for (size_t i = 0; i < count && picked < k; i++) {
+            if (label_index(train[i]->label, false) != l) {
+                continue;
+            }
+            // the picked-th template is member picked * members / k
+            if (seen++ != (size_t)picked * members / k) {
+                continue;
+            }
+            gesture_frame_from_points(train[i]->pts, train[i]->n, &t[picked_total].frame);
+            t[picked_total].label = (uint8_t)l;
+            is_template[i] = true;
+            picked_total++;
+            picked++;
+        }
+    }
+    return picked_total;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Percentile of the best-template distances of the labelled train strokes
+// that are not templates themselves
+static uint32_t auto_reject(const gesture_model_t *model, const wand_stroke_t **train,
+                            size_t count, const bool *is_template, int percentile)
+{
+    uint32_t *d = malloc((count + 1) * sizeof(*d));
+    size_t n = 0;
+    gesture_frame_t frame;
+
+    if (d == NULL) {
+        return GESTURE_DIST_MAX;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (is_template[i] || label_index(train[i]->label, false) < 0) {
+            continue;
+        }
+        gesture_frame_from_points(train[i]->pts, train[i]->n, &frame);
+        gesture_classify(model, &frame, &d[n++]);
+    }
+
+    uint32_t r = GESTURE_DIST_MAX;
+
+    if (n > 0) {
+        qsort(d, n, sizeof(*d), cmp_u32);
+        r = d[((n - 1) * (size_t)percentile + 50) / 100];
+    }
+    free(d);
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    int k = 8;
+    int folds = 5;
+    int percentile = 95;
+    long reject = -1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:f:p:r:")) != -1) {
+        switch (opt) {
+        case 'k': k = atoi(optarg); break;
+        case 'f': folds = atoi(optarg); break;
+        case 'p': percentile = atoi(optarg); break;
+        case 'r': reject = atol(optarg); break;
+        default:  optind = argc + 1; break;
+        }
+    }
+    if (optind >= argc || k < 1 || folds < 2 || percentile < 0 || percentile > 100) {
+        fprintf(stderr, "usage: %s [-k templates] [-f folds] [-p percentile | -r reject_distance]"
+                " dataset.json...\n", argv[0]);
+        return 2;
+    }
+
+    int files = argc - optind;
+    wand_dataset_t *ds = calloc((size_t)files, sizeof(*ds));
+    size_t strokes = 0;
+
+    double load_ns = now_ns();
+
+    for (int i = 0; i < files; i++) {
+        if (wand_dataset_load(argv[optind + i], &ds[i]) != 0) {
+            return 1;
+        }
+        strokes += ds[i].count;
+    }
+    load_ns = now_ns() - load_ns;
+
+    const wand_stroke_t **pool = malloc((strokes + 1) * sizeof(*pool));
+    const wand_stroke_t **train = malloc((strokes + 1) * sizeof(*train));
+    const wand_stroke_t **test = malloc((strokes + 1) * sizeof(*test));
+    bool *is_template = malloc(strokes + 1);
+    gesture_template_t *templates = calloc((size_t)k * MAX_LABELS, sizeof(*templates));
+    size_t unique = 0;
+
+    if (pool == NULL || train == NULL || test == NULL || is_template == NULL ||
+        templates == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < files; i++) {
+        unique = add_unique(pool, unique, &ds[i]);
+    }
+    if (label_count == 0) {
+        fprintf(stderr, "no labelled strokes\n");
+        return 1;
+    }
+
+    printf("%zu strokes loaded in %.2f ms, %zu unique, %d labels, %d folds\n", strokes,
+           load_ns / 1e6, unique, label_count, folds);
+    printf("%d templates per label, %d points, band %d\n\n", k, GESTURE_POINTS, GESTURE_DTW_BAND);
+
+    // test labels the model does not know are expected to be rejected.
+    // Labelled strokes are tested once, in their fold; unlabeled strokes
+    // are never trained on and are tested in every fold.
+    int total[MAX_LABELS + 1] = { 0 };
+    int correct[MAX_LABELS + 1] = { 0 };
+    double prep_ns = 0.0, classify_ns = 0.0;
+    uint64_t prep_cyc = 0, classify_cyc = 0, classify_cyc_max = 0;
+    uint16_t model_size = 0;
+
+    for (int f = 0; f < folds; f++) {
+        size_t n_train = 0, n_test = 0, rank = 0;
+
+        for (size_t i = 0; i < unique; i++) {
+            if (label_index(pool[i]->label, false) < 0 || rank++ % folds == (size_t)f) {
+                test[n_test++] = pool[i];
+            } else {
+                train[n_train++] = pool[i];
+            }
+        }
+
+        gesture_model_t model = { .templates = templates, .labels = label_ptrs,
+                                  .label_count = (uint8_t)label_count };
+
+        memset(is_template, 0, strokes + 1);
+        model.count = pick_templates(train, n_train, k, templates, is_template);
+        model.reject_distance = (reject >= 0)
+                                ? (uint32_t)reject
+                                : auto_reject(&model, train, n_train, is_template, percentile);
+        model_size = model.count;
+
+        printf("fold %d: %zu train, %zu test, reject above %u\n", f, n_train, n_test,
+               model.reject_distance);
+
+        for (size_t i = 0; i < n_test; i++) {
+            const wand_stroke_t *st = test[i];
+            int expected = label_index(st->label, false);
+            int slot = (expected < 0) ? MAX_LABELS : expected;
+            gesture_frame_t frame;
+            uint32_t d;
+
+            double t0 = now_ns();
+            uint64_t c0 = cycles();
+            gesture_frame_from_points(st->pts, st->n, &frame);
+            uint64_t c1 = cycles();
+            double t1 = now_ns();
+            int got = gesture_classify(&model, &frame, &d);
+            uint64_t c2 = cycles();
+            double t2 = now_ns();
+
+            prep_ns += t1 - t0;
+            classify_ns += t2 - t1;
+            prep_cyc += c1 - c0;
+            classify_cyc += c2 - c1;
+            classify_cyc_max = (c2 - c1 > classify_cyc_max) ? c2 - c1 : classify_cyc_max;
+
+            total[slot]++;
+            correct[slot] += got == expected;
+            if (got != expected) {
+                printf("  stroke %4d: %-8s -> %-8s distance %u\n", st->index,
+                       gesture_label_name(&model, expected), gesture_label_name(&model, got), d);
+            }
+        }
+    }
+
+    gesture_model_t names = { .labels = label_ptrs, .label_count = (uint8_t)label_count };
+    int all = 0, all_correct = 0;
+
+    printf("\n%-8s %8s %8s %8s\n", "class", "tests", "correct", "acc %");
+    for (int slot = 0; slot <= MAX_LABELS; slot++) {
+        if (total[slot] == 0) {
+            continue;
+        }
+        printf("%-8s %8d %8d %8.1f\n",
+               gesture_label_name(&names, (slot == MAX_LABELS) ? GESTURE_REJECT : slot),
+               total[slot], correct[slot], 100.0 * correct[slot] / total[slot]);
+        all += total[slot];
+        all_correct += correct[slot];
+    }
+    printf("%-8s %8d %8d %8.1f\n\n", "all", all, all_correct, 100.0 * all_correct / all);
+
+    printf("per stroke:   frame %8.0f ns %8.0f cycles\n", prep_ns / all, (double)prep_cyc / all);
+    printf("           classify %8.0f ns %8.0f cycles (max %llu)\n", classify_ns / all,
+           (double)classify_cyc / all, (unsigned long long)classify_cyc_max);
+    printf("worst case %u DTW cells per stroke\n",
+           (unsigned)model_size * GESTURE_POINTS * (2 * GESTURE_DTW_BAND + 1));
+
+    for (int i = 0; i < files; i++) {
+        wand_dataset_free(&ds[i]);
+    }
+    free(ds);
+    free(pool);
+    free(train);
+    free(test);
+    free(is_template);
+    free(templates);
+    return 0;
+}
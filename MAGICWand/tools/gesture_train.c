@@ -0,0 +1,557 @@
+/* Trains the common/gesture template model from the wand datasets and
+ * writes it as a C header, with golden vectors for checking the firmware
+ *
+ *     cc -O2 -I../common/gesture tools/gesture_train.c tools/wand_json.c \
+ *        tools/wand_data.c ../common/gesture/gesture.c \
+ *        ../common/gesture/stroke_pack.c -lm -o gesture_train
+ *     ./gesture_train -o model/gesture_model.h -g model/gesture_golden.h \
+ *        100_b_strokes_combined.json ../wanddata_combined_preserve_classes.json
+ *
+ * Labelled strokes (duplicates dropped) are split: every -f th one is held
+ * out for validation, the others are augmented -a times each with a random
+ * rotation (+-R degrees), an x/y scale (+-15%) and per-point jitter (+-J Q8
+ * units). The templates are -k medoids per label of the training frames
+ * under the same DTW the firmware uses. Unlabeled strokes are the reject
+ * class: the reject distance is the one that best balances accepting the
+ * validation strokes and rejecting the unlabeled ones while still accepting
+ * at least -A percent of the validation strokes (the -A th percentile of
+ * the validation distances when there are no unlabeled strokes).
+ *
+ * Every frame and distance comes from gesture.c itself, so the golden
+ * vectors (validation and unlabeled strokes with the label and distance the
+ * model gives them) are bit-exact for any build of the same code, see
+ * MAGICWand/golden_check.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gesture.h"
+#include "wand_json.h"
+
+#define MAX_LABELS  16
+#define KMEDOID_ITERATIONS 20
+
+static char label_names[MAX_LABELS][WAND_LABEL_MAX];
+static int label_count;
+
+static uint32_t rng = 2463534242u;
+
+// Label index, added on first use; GESTURE_REJECT for ""
+static int label_index(const char *label, bool add)
+{
+    if (label[0] == '\0') {
+        return GESTURE_REJECT;
+    }
+    for (int i = 0; i < label_count; i++) {
+        if (strcmp(label_names[i], label) == 0) {
+            return i;
+        }
+    }
+    if (!add || label_count == MAX_LABELS) {
+        return GESTURE_REJECT;
+    }
+    snprintf(label_names[label_count], WAND_LABEL_MAX, "%s", label);
+    return label_count++;
+}
+
+static bool same_stroke(const wand_stroke_t *a, const wand_stroke_t *b)
+{
+    return a->n == b->n && memcmp(a->pts, b->pts, a->n * sizeof(*a->pts)) == 0 &&
+           strcmp(a->label, b->label) == 0;
+}
+
+// xorshift32, uniform in [-1, 1]
+static double uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng / 2147483647.5 - 1.0;
+}
+
+static void augment(const wand_stroke_t *st, gesture_point_t *out, double max_deg,
+                    double jitter)
+{
+    double a = uniform() * max_deg * M_PI / 180.0;
+    double sx = 1.0 + 0.15 * uniform();
+    double sy = 1.0 + 0.15 * uniform();
+
+    for (size_t i = 0; i < st->n; i++) {
+        double x = st->pts[i].x * sx;
+        double y = st->pts[i].y * sy;
+
+        out[i].x = (int16_t)lround(x * cos(a) - y * sin(a) + jitter * uniform());
+        out[i].y = (int16_t)lround(x * sin(a) + y * cos(a) + jitter * uniform());
+    }
+}
+
+// k medoids of frames[0..m-1]: farthest-point start, then alternate
+// assignment and medoid update. Returns the medoid count (<= k).
+static int kmedoids(const gesture_frame_t *frames, int m, int k, int *medoid)
+{
+    uint32_t *d = malloc((size_t)m * m * sizeof(*d));
+    int *owner = malloc((size_t)m * sizeof(*owner));
+
+    if (d == NULL || owner == NULL) {
+        free(d);
+        free(owner);
+        return 0;
+    }
+
+    for (int i = 0; i < m; i++) {
+        d[i * m + i] = 0;
+        for (int j = i + 1; j < m; j++) {
+            d[i * m + j] = d[j * m + i] = gesture_dtw(&frames[i], &frames[j], GESTURE_DIST_MAX);
+        }
+    }
+
+    k = (k < m) ? k : m;
+
+    // first the most central frame, then the one farthest from all medoids
+    uint64_t best_sum = UINT64_MAX;
+
+    for (int i = 0; i < m; i++) {
+        uint64_t sum = 0;
+
+        for (int j = 0; j < m; j++) {
+            sum += d[i * m + j];
+        }
+        if (sum < best_sum) {
+            best_sum = sum;
+            medoid[0] = i;
+        }
+    }
+    for (int c = 1; c < k; c++) {
+        uint32_t far = 0;
+
+        medoid[c] = medoid[0];
+        for (int i = 0; i < m; i++) {
+            uint32_t near = UINT32_MAX;
+
+            for (int e = 0; e < c; e++) {
+                near = (d[i * m + medoid[e]] < near) ? d[i * m + medoid[e]] : near;
+            }
+            if (near > far) {
+                far = near;
+                medoid[c] = i;
+            }
+        }
+    }
+
+    for (int it = 0; it < KMEDOID_ITERATIONS; it++) {
+        bool changed = false;
+
+        for (int i = 0; i < m; i++) {
+            owner[i] = 0;
+            for (int c = 1; c < k; c++) {
+                if (d[i * m + medoid[c]] < d[i * m + medoid[owner[i]]]) {
+                    owner[i] = c;
+                }
+            }
+        }
+        for (int c = 0; c < k; c++) {
+            uint64_t cost_best = UINT64_MAX;
+            int pick = medoid[c];
+
+            for (int i = 0; i < m; i++) {
+                if (owner[i] != c) {
+                    continue;
+                }
+
+                uint64_t cost = 0;
+
+                for (int j = 0; j < m; j++) {
+                    cost += (owner[j] == c) ? d[i * m + j] : 0;
+                }
+                if (cost < cost_best) {
+                    cost_best = cost;
+                    pick = i;
+                }
+            }
+            changed |= pick != medoid[c];
+            medoid[c] = pick;
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    free(d);
+    free(owner);
+    return k;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Reject distance with the best balanced accuracy between accepting the
+// in-class distances and rejecting the impostor ones, accepting at least
+// min_accept percent of the in-class ones
+static uint32_t calibrate(const uint32_t *in, int n_in, const uint32_t *out, int n_out,
+                          int min_accept)
+{
+    uint32_t *sorted = malloc(((size_t)n_in + 1) * sizeof(*sorted));
+    uint32_t best_t = GESTURE_DIST_MAX;
+
+    if (sorted == NULL || n_in == 0) {
+        free(sorted);
+        return best_t;
+    }
+    memcpy(sorted, in, (size_t)n_in * sizeof(*in));
+    qsort(sorted, (size_t)n_in, sizeof(*sorted), cmp_u32);
+
+    int first = (n_in * min_accept + 99) / 100 - 1;     // fewest accepted, minus one
+
+    first = (first < 0) ? 0 : first;
+    if (n_out == 0) {
+        best_t = sorted[first];
+        free(sorted);
+        return best_t;
+    }
+
+    double best = -1.0;
+
+    for (int c = first; c < n_in; c++) {
+        uint32_t t = sorted[c];
+        int accepted = c + 1, rejected = 0;
+
+        while (accepted < n_in && sorted[accepted] <= t) {
+            accepted++;
+        }
+        for (int i = 0; i < n_out; i++) {
+            rejected += out[i] > t;
+        }
+
+        double score = 0.5 * accepted / n_in + 0.5 * rejected / n_out;
+
+        if (score > best) {
+            best = score;
+            best_t = t;
+        }
+    }
+    free(sorted);
+    return best_t;
+}
+
+static void write_frame(FILE *f, const gesture_frame_t *fr, const char *indent)
+{
+    for (int k = 0; k < GESTURE_POINTS; k++) {
+        fprintf(f, "%s{ %4d, %4d },%s", (k % 4 == 0) ? indent : "", fr->pt[k][0], fr->pt[k][1],
+                (k % 4 == 3) ? "\n" : " ");
+    }
+}
+
+static int write_model(const char *path, const gesture_model_t *model, const char *cmdline)
+{
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(f, "/* Generated by MAGICWand/tools/gesture_train.c, do not edit\n"
+               " *\n *     %s\n */\n", cmdline);
+    fprintf(f, "#ifndef GESTURE_MODEL_H\n#define GESTURE_MODEL_H\n\n#include \"gesture.h\"\n\n");
+    fprintf(f, "#if GESTURE_POINTS != %d || GESTURE_DTW_BAND != %d\n"
+               "#error \"gesture_model.h was trained for another gesture.h, regenerate it\"\n"
+               "#endif\n\n", GESTURE_POINTS, GESTURE_DTW_BAND);
+
+    fprintf(f, "static const char *const gesture_model_labels[%d] = {", model->label_count);
+    for (int l = 0; l < model->label_count; l++) {
+        fprintf(f, " \"%s\",", model->labels[l]);
+    }
+    fprintf(f, " };\n\n");
+
+    fprintf(f, "static const gesture_template_t gesture_model_templates[%u] = {\n", model->count);
+    for (uint16_t t = 0; t < model->count; t++) {
+        fprintf(f, "    { .label = %u, .frame = { .pt = {\n", model->templates[t].label);
+        write_frame(f, &model->templates[t].frame, "        ");
+        fprintf(f, "    } } },\n");
+    }
+    fprintf(f, "};\n\n");
+
+    fprintf(f, "static const gesture_model_t gesture_model = {\n"
+               "    .templates       = gesture_model_templates,\n"
+               "    .count           = %u,\n"
+               "    .reject_distance = %u,\n"
+               "    .labels          = gesture_model_labels,\n"
+               "    .label_count     = %u,\n"
+               "};\n\n#endif /* GESTURE_MODEL_H */\n",
+            model->count, model->reject_distance, model->label_count);
+    fclose(f);
+    return 0;
+}
+
+static int write_golden(const char *path, const wand_stroke_t **st, int n,
+                        const gesture_model_t *model, const char *cmdline)
+{
+    FILE *f = fopen(path, "w");
+    size_t offset = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(f, "/* Generated by MAGICWand/tools/gesture_train.c, do not edit\n"
+               " *\n *     %s\n *\n"
+               " * Strokes with the frame, label and distance gesture_model.h gives them.\n"
+               " */\n", cmdline);
+    fprintf(f, "#ifndef GESTURE_GOLDEN_H\n#define GESTURE_GOLDEN_H\n\n#include \"gesture.h\"\n\n");
+    fprintf(f, "typedef struct {\n"
+               "    uint16_t        offset;     // first point in gesture_golden_points\n"
+               "    uint16_t        count;\n"
+               "    int8_t          label;      // or GESTURE_REJECT\n"
+               "    uint32_t        distance;\n"
+               "    gesture_frame_t frame;\n"
+               "} gesture_golden_t;\n\n");
+
+    fprintf(f, "static const gesture_point_t gesture_golden_points[] = {\n");
+    for (int i = 0; i < n; i++) {
+        for (size_t p = 0; p < st[i]->n; p++) {
+            fprintf(f, "%s{ %d, %d },%s", (p % 6 == 0) ? "    " : "", st[i]->pts[p].x,
+                    st[i]->pts[p].y, (p % 6 == 5 || p + 1 == st[i]->n) ? "\n" : " ");
+        }
+    }
+    fprintf(f, "};\n\n");
+
+    fprintf(f, "static const gesture_golden_t gesture_golden[%d] = {\n", n);
+    for (int i = 0; i < n; i++) {
+        gesture_frame_t frame;
+        uint32_t d;
+
+        gesture_frame_from_points(st[i]->pts, st[i]->n, &frame);
+
+        int label = gesture_classify(model, &frame, &d);
+
+        fprintf(f, "    { .offset = %zu, .count = %zu, .label = %d, .distance = %u,"
+                   "  /* stroke %d \"%s\" */\n      .frame = { .pt = {\n",
+                offset, st[i]->n, label, d, st[i]->index, st[i]->label);
+        write_frame(f, &frame, "        ");
+        fprintf(f, "    } } },\n");
+        offset += st[i]->n;
+    }
+    fprintf(f, "};\n\n#endif /* GESTURE_GOLDEN_H */\n");
+    fclose(f);
+
+    if (offset > UINT16_MAX) {
+        fprintf(stderr, "%s: too many golden points\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *model_path = NULL, *golden_path = NULL;
+    int k = 8, folds = 5, copies = 4, golden_max = 12, min_accept = 90;
+    double max_deg = 15.0, jitter = 2.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:g:k:f:a:A:R:J:n:S:")) != -1) {
+        switch (opt) {
+        case 'o': model_path = optarg; break;
+        case 'g': golden_path = optarg; break;
+        case 'k': k = atoi(optarg); break;
+        case 'f': folds = atoi(optarg); break;
+        case 'a': copies = atoi(optarg); break;
+        case 'A': min_accept = atoi(optarg); break;
+        case 'R': max_deg = atof(optarg); break;
+        case 'J': jitter = atof(optarg); break;
+        case 'n': golden_max = atoi(optarg); break;
+        case 'S': rng = (uint32_t)strtoul(optarg, NULL, 0) | 1; break;
+        default:  optind = argc + 1; break;
+        }
+    }
+    if (optind >= argc || model_path == NULL || k < 1 || folds < 2 || copies < 0 ||
+        golden_max < 0 || min_accept < 0 || min_accept > 100) {
+        fprintf(stderr, "usage: %s -o model.h [-g golden.h] [-k medoids] [-f holdout] "
+                "[-a copies] [-A min_accept%%] [-R degrees] [-J jitter] [-n golden] [-S seed] dataset...\n",
+                argv[0]);
+        return 2;
+    }
+
+    // the command line goes into the headers, so they can be regenerated
+    char cmdline[512] = "gesture_train";
+
+    for (int i = 1; i < argc; i++) {
+        size_t len = strlen(cmdline);
+
+        snprintf(cmdline + len, sizeof(cmdline) - len, " %s", argv[i]);
+    }
+
+    int files = argc - optind;
+    wand_dataset_t *ds = calloc((size_t)files, sizeof(*ds));
+    size_t total = 0;
+
+    for (int i = 0; i < files; i++) {
+        if (wand_dataset_load(argv[optind + i], &ds[i]) != 0) {
+            return 1;
+        }
+        total += ds[i].count;
+    }
+
+    // unique strokes, split into training, validation and unlabeled
+    const wand_stroke_t **train = malloc((total + 1) * sizeof(*train));
+    const wand_stroke_t **valid = malloc((total + 1) * sizeof(*valid));
+    const wand_stroke_t **unlab = malloc((total + 1) * sizeof(*unlab));
+    const wand_stroke_t **seen = malloc((total + 1) * sizeof(*seen));
+    int n_train = 0, n_valid = 0, n_unlab = 0, n_seen = 0, rank = 0;
+    size_t max_n = 0;
+
+    for (int i = 0; i < files; i++) {
+        for (size_t j = 0; j < ds[i].count; j++) {
+            const wand_stroke_t *st = &ds[i].strokes[j];
+            int s = 0;
+
+            while (s < n_seen && !same_stroke(seen[s], st)) {
+                s++;
+            }
+            if (s < n_seen || st->n == 0) {
+                continue;
+            }
+            seen[n_seen++] = st;
+            max_n = (st->n > max_n) ? st->n : max_n;
+
+            if (label_index(st->label, true) < 0) {
+                unlab[n_unlab++] = st;
+            } else if (rank++ % folds == 0) {
+                valid[n_valid++] = st;
+            } else {
+                train[n_train++] = st;
+            }
+        }
+    }
+    if (label_count == 0 || n_train == 0) {
+        fprintf(stderr, "no labelled strokes to train on\n");
+        return 1;
+    }
+
+    // training frames: every stroke plus its augmented copies
+    int m_max = n_train * (copies + 1);
+    gesture_frame_t *frames = malloc((size_t)m_max * sizeof(*frames));
+    gesture_point_t *aug = malloc((max_n + 1) * sizeof(*aug));
+    static gesture_template_t templates[MAX_LABELS * UINT8_MAX];
+    static const char *label_ptrs[MAX_LABELS];
+    gesture_model_t model = { .templates = templates, .labels = label_ptrs,
+                              .label_count = (uint8_t)label_count };
+    int *medoid = malloc(((size_t)k + 1) * sizeof(*medoid));
+
+    if (frames == NULL || aug == NULL || medoid == NULL || k > UINT8_MAX) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (int l = 0; l < label_count; l++) {
+        int m = 0;
+
+        label_ptrs[l] = label_names[l];
+        for (int i = 0; i < n_train; i++) {
+            if (label_index(train[i]->label, false) != l) {
+                continue;
+            }
+            gesture_frame_from_points(train[i]->pts, train[i]->n, &frames[m++]);
+            for (int c = 0; c < copies; c++) {
+                augment(train[i], aug, max_deg, jitter);
+                gesture_frame_from_points(aug, train[i]->n, &frames[m++]);
+            }
+        }
+
+        int got = kmedoids(frames, m, k, medoid);
+
+        for (int c = 0; c < got; c++) {
+            templates[model.count].frame = frames[medoid[c]];
+            templates[model.count].label = (uint8_t)l;
+            model.count++;
+        }
+        printf("label %-8s %4d training frames -> %d templates\n", label_names[l], m, got);
+    }
+
+    // reject distance from the validation and unlabeled strokes
+    uint32_t *d_in = malloc(((size_t)n_valid + 1) * sizeof(*d_in));
+    uint32_t *d_out = malloc(((size_t)n_unlab + 1) * sizeof(*d_out));
+    int *got_in = malloc(((size_t)n_valid + 1) * sizeof(*got_in));
+    gesture_frame_t frame;
+
+    model.reject_distance = GESTURE_DIST_MAX;
+    for (int i = 0; i < n_valid; i++) {
+        gesture_frame_from_points(valid[i]->pts, valid[i]->n, &frame);
+        got_in[i] = gesture_classify(&model, &frame, &d_in[i]);
+    }
+    for (int i = 0; i < n_unlab; i++) {
+        gesture_frame_from_points(unlab[i]->pts, unlab[i]->n, &frame);
+        gesture_classify(&model, &frame, &d_out[i]);
+    }
+    model.reject_distance = calibrate(d_in, n_valid, d_out, n_unlab, min_accept);
+
+    int ok_in = 0, ok_out = 0;
+
+    for (int i = 0; i < n_valid; i++) {
+        ok_in += d_in[i] <= model.reject_distance &&
+                 got_in[i] == label_index(valid[i]->label, false);
+    }
+    for (int i = 0; i < n_unlab; i++) {
+        ok_out += d_out[i] > model.reject_distance;
+    }
+
+    printf("\n%d unique strokes of %zu: %d train, %d validation, %d unlabeled\n",
+           n_seen, total, n_train, n_valid, n_unlab);
+    printf("reject above %u\n", model.reject_distance);
+    if (n_valid > 0) {
+        printf("validation   %d/%d recognised (%.1f%%)\n", ok_in, n_valid, 100.0 * ok_in / n_valid);
+    }
+    if (n_unlab > 0) {
+        printf("unlabeled    %d/%d rejected (%.1f%%), also used to set the reject distance\n",
+               ok_out, n_unlab, 100.0 * ok_out / n_unlab);
+    }
+    printf("model        %zu bytes of const templates\n", model.count * sizeof(templates[0]));
+
+    if (write_model(model_path, &model, cmdline) != 0) {
+        return 1;
+    }
+
+    if (golden_path != NULL) {
+        // validation strokes first, then every unlabeled one that fits
+        const wand_stroke_t **golden = malloc(((size_t)golden_max + 1) * sizeof(*golden));
+        int n_golden = 0;
+        int from_valid = golden_max - ((n_unlab < golden_max / 2) ? n_unlab : golden_max / 2);
+
+        for (int i = 0; i < n_valid && n_golden < from_valid; i++) {
+            golden[n_golden++] = valid[i];
+        }
+        for (int i = 0; i < n_unlab && n_golden < golden_max; i++) {
+            golden[n_golden++] = unlab[i];
+        }
+        if (write_golden(golden_path, golden, n_golden, &model, cmdline) != 0) {
+            return 1;
+        }
+        printf("golden       %d strokes\n", n_golden);
+        free(golden);
+    }
+
+    for (int i = 0; i < files; i++) {
+        wand_dataset_free(&ds[i]);
+    }
+    free(ds);
+    free(train);
+    free(valid);
+    free(unlab);
+    free(seen);
+    free(frames);
+    free(aug);
+    free(medoid);
+    free(d_in);
+    free(d_out);
+    free(got_in);
+    return 0;
+}
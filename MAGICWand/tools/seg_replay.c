@@ -0,0 +1,210 @@
+/* Replays the wand recordings as one live stream through the streaming
+ * segmentation (common/gesture/stroke_seg.c)
+ *
+ *     cc -O2 -I../common/gesture tools/seg_replay.c tools/wand_json.c \
+ *        tools/wand_data.c ../common/gesture/gesture.c \
+ *        ../common/gesture/stroke_pack.c ../common/gesture/stroke_seg.c \
+ *        -lm -o seg_replay
+ *     ./seg_replay [-g gap] [-c chunk] [-s start] [-e stop] [-H hold]
+ *                  dataset.json|.wpk...
+ *
+ * Strokes are played back to back, each moved to start where the previous
+ * one ended (the recordings have unrelated origins) and followed by -g
+ * copies of its last point. Points go through the SPSC ring in chunks of
+ * -c, as a sensor callback would deliver them. -s, -e and -H override the
+ * thresholds (raw stroke_seg_cfg_t energies) and the hold of the default
+ * configuration, for tuning.
+ *
+ * Prints how many strokes gave exactly one frame, none or several, the
+ * position of the frames relative to the end of their recordings, the DTW
+ * distance between each segmented frame and the frame of its whole
+ * recording, the cycles per point and the RAM of the stage.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#include "gesture.h"
+#include "stroke_seg.h"
+#include "wand_json.h"
+
+typedef struct {
+    gesture_point_t p;
+    uint32_t        stroke;     // source stroke, for attributing frames
+} stream_point_t;
+
+static uint64_t cycles(void)
+{
+#if HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    int gap = 20;
+    int chunk = 8;
+    stroke_seg_cfg_t cfg = stroke_seg_default_cfg;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "g:c:s:e:H:")) != -1) {
+        switch (opt) {
+        case 'g': gap = atoi(optarg); break;
+        case 'c': chunk = atoi(optarg); break;
+        case 's': cfg.start_energy = (uint16_t)atoi(optarg); break;
+        case 'e': cfg.stop_energy = (uint16_t)atoi(optarg); break;
+        case 'H': cfg.hold = (uint8_t)atoi(optarg); break;
+        default:  optind = argc + 1; break;
+        }
+    }
+    if (optind >= argc || gap < 0 || chunk < 1 || chunk > STROKE_RING_SLOTS) {
+        fprintf(stderr, "usage: %s [-g gap] [-c chunk <= %d] [-s start] [-e stop] [-H hold]"
+                " dataset.json|.wpk...\n", argv[0], STROKE_RING_SLOTS);
+        return 2;
+    }
+
+    int files = argc - optind;
+    wand_dataset_t *ds = calloc((size_t)files, sizeof(*ds));
+    size_t strokes = 0, points = 0;
+
+    for (int i = 0; i < files; i++) {
+        if (wand_dataset_load(argv[optind + i], &ds[i]) != 0) {
+            return 1;
+        }
+        strokes += ds[i].count;
+        for (size_t j = 0; j < ds[i].count; j++) {
+            points += ds[i].strokes[j].n + (size_t)gap;
+        }
+    }
+
+    const wand_stroke_t **src = malloc((strokes + 1) * sizeof(*src));
+    stream_point_t *stream = malloc((points + 1) * sizeof(*stream));
+    size_t *rec_end = malloc((strokes + 1) * sizeof(*rec_end));
+    int *frames = calloc(strokes + 1, sizeof(*frames));
+    uint32_t *dist = malloc((strokes + 1) * sizeof(*dist));
+    size_t n = 0, ns = 0;
+
+    if (src == NULL || stream == NULL || rec_end == NULL || frames == NULL || dist == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // build the stream, remembering where each recording ends
+    gesture_point_t at = { 0, 0 };
+
+    for (int i = 0; i < files; i++) {
+        for (size_t j = 0; j < ds[i].count; j++) {
+            const wand_stroke_t *st = &ds[i].strokes[j];
+
+            if (st->n == 0) {
+                continue;
+            }
+
+            int32_t ox = at.x - st->pts[0].x;
+            int32_t oy = at.y - st->pts[0].y;
+
+            for (size_t k = 0; k < st->n; k++) {
+                stream[n].p.x = (int16_t)(st->pts[k].x + ox);
+                stream[n].p.y = (int16_t)(st->pts[k].y + oy);
+                stream[n].stroke = (uint32_t)ns;
+                n++;
+            }
+            rec_end[ns] = n - 1;
+            at = stream[n - 1].p;
+            for (int k = 0; k < gap; k++) {
+                stream[n].p = at;
+                stream[n].stroke = (uint32_t)ns;
+                n++;
+            }
+            src[ns++] = st;
+        }
+    }
+
+    static stroke_ring_t ring;
+    static stroke_seg_t seg;
+    gesture_frame_t frame, whole;
+    uint64_t busy = 0;
+    long early_sum = 0, early_min = 0;
+    size_t fed = 0, emitted = 0;
+
+    stroke_ring_init(&ring);
+    stroke_seg_init(&seg, &cfg);
+
+    while (fed < n) {
+        size_t end = (fed + (size_t)chunk < n) ? fed + (size_t)chunk : n;
+
+        for (; fed < end; fed++) {
+            stroke_ring_put(&ring, stream[fed].p);
+        }
+
+        // the consumer drains the chunk; the ring tail tells which point
+        // completed each stroke
+        for (;;) {
+            uint64_t c0 = cycles();
+            bool got = stroke_seg_poll(&seg, &ring, &frame);
+
+            busy += cycles() - c0;
+            if (!got) {
+                break;
+            }
+
+            size_t pos = atomic_load(&ring.tail) - 1;
+            uint32_t s = stream[pos].stroke;
+            long early = (long)rec_end[s] - (long)pos;
+
+            if (frames[s]++ == 0) {
+                gesture_frame_from_points(src[s]->pts, src[s]->n, &whole);
+                dist[s] = gesture_dtw(&frame, &whole, GESTURE_DIST_MAX);
+            }
+            early_sum += early;
+            early_min = (emitted == 0 || early < early_min) ? early : early_min;
+            emitted++;
+        }
+    }
+
+    size_t one = 0, none = 0, split = 0;
+    uint64_t dist_sum = 0;
+    uint32_t dist_max = 0;
+
+    for (size_t s = 0; s < ns; s++) {
+        one += frames[s] == 1;
+        none += frames[s] == 0;
+        split += frames[s] > 1;
+        if (frames[s] > 0) {
+            dist_sum += dist[s];
+            dist_max = (dist[s] > dist_max) ? dist[s] : dist_max;
+        }
+    }
+
+    printf("%zu strokes, %zu points (gap %d, chunks of %d)\n\n", ns, n, gap, chunk);
+    printf("frames       %zu (one %zu, none %zu, split %zu, %u dropped as too short)\n",
+           emitted, one, none, split, seg.dropped);
+    if (emitted > 0) {
+        printf("early        %.1f points avg (%ld min) before the recording ends\n",
+               (double)early_sum / emitted, early_min);
+        printf("vs whole     DTW %.0f avg, %u max\n",
+               (double)dist_sum / (double)(ns - none), dist_max);
+    }
+    printf("cost         %.0f cycles per point\n", (double)busy / n);
+    printf("RAM          %zu bytes segmenter + %zu bytes ring\n", sizeof(seg), sizeof(ring));
+
+    for (int i = 0; i < files; i++) {
+        wand_dataset_free(&ds[i]);
+    }
+    free(ds);
+    free(src);
+    free(stream);
+    free(rec_end);
+    free(frames);
+    free(dist);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/* Packed dataset loading for the host tools, see wand_json.h */
+#include "wand_json.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "stroke_pack.h"
+
+static int load_from_pack(const stroke_pack_t *pack, wand_dataset_t *ds)
+{
+    ds->strokes = calloc(pack->stroke_count + 1, sizeof(*ds->strokes));
+    if (ds->strokes == NULL) {
+        return -1;
+    }
+
+    for (uint16_t i = 0; i < pack->stroke_count; i++) {
+        wand_stroke_t *st = &ds->strokes[i];
+        stroke_info_t info;
+        stroke_reader_t rd;
+
+        if (stroke_pack_info(pack, i, &info) != 0 || stroke_pack_read_begin(pack, i, &rd) != 0) {
+            return -1;
+        }
+        st->index = info.index;
+        snprintf(st->label, sizeof(st->label), "%s", stroke_pack_label(pack, info.label));
+        st->pts = malloc((info.points + 1) * sizeof(*st->pts));
+        ds->count++;
+        if (st->pts == NULL || stroke_pack_read(&rd, st->pts, info.points) != info.points) {
+            return -1;
+        }
+        st->n = info.points;
+    }
+    return 0;
+}
+
+int wand_pack_load(const char *path, wand_dataset_t *ds)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat sb;
+    stroke_pack_t pack;
+    int err = -1;
+
+    memset(ds, 0, sizeof(*ds));
+    if (fd < 0 || fstat(fd, &sb) != 0 || sb.st_size == 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+
+    if (stroke_pack_open(&pack, map, (size_t)sb.st_size) == 0) {
+        err = load_from_pack(&pack, ds);
+    }
+    munmap(map, (size_t)sb.st_size);
+
+    if (err != 0) {
+        fprintf(stderr, "%s: damaged pack\n", path);
+        wand_dataset_free(ds);
+    }
+    return err;
+}
+
+int wand_dataset_load(const char *path, wand_dataset_t *ds)
+{
+    FILE *f = fopen(path, "rb");
+    char magic[4] = { 0 };
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    size_t got = fread(magic, 1, sizeof(magic), f);
+
+    fclose(f);
+    if (got == sizeof(magic) && memcmp(magic, "WAND", 4) == 0) {
+        return wand_pack_load(path, ds);
+    }
+    return wand_json_load(path, ds);
+}
@@ -0,0 +1,311 @@
+/* Magic wand JSON dataset reader, see wand_json.h
+ *
+ * A small recursive descent parser for the subset of JSON the datasets
+ * use; strings are not unescaped beyond skipping \x pairs, which is enough
+ * for labels.
+ */
+#include "wand_json.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char *s;
+    const char *pos;
+    const char *end;
+    bool        err;
+} parser_t;
+
+static void fail(parser_t *p, const char *what)
+{
+    if (!p->err) {
+        fprintf(stderr, "json: %s at byte %ld\n", what, (long)(p->pos - p->s));
+    }
+    p->err = true;
+}
+
+static void skip_ws(parser_t *p)
+{
+    while (p->pos < p->end && isspace((unsigned char)*p->pos)) {
+        p->pos++;
+    }
+}
+
+static bool accept(parser_t *p, char c)
+{
+    skip_ws(p);
+    if (p->pos < p->end && *p->pos == c) {
+        p->pos++;
+        return true;
+    }
+    return false;
+}
+
+static void expect(parser_t *p, char c)
+{
+    if (!accept(p, c)) {
+        char msg[] = "expected 'x'";
+
+        msg[10] = c;
+        fail(p, msg);
+    }
+}
+
+// Copies at most size - 1 characters, the rest of the string is skipped
+static void parse_string(parser_t *p, char *out, size_t size)
+{
+    size_t len = 0;
+
+    expect(p, '"');
+    while (!p->err && p->pos < p->end && *p->pos != '"') {
+        if (*p->pos == '\\' && p->pos + 1 < p->end) {
+            p->pos++;
+        }
+        if (out != NULL && len + 1 < size) {
+            out[len++] = *p->pos;
+        }
+        p->pos++;
+    }
+    if (out != NULL && size > 0) {
+        out[len] = '\0';
+    }
+    expect(p, '"');
+}
+
+static double parse_number(parser_t *p)
+{
+    char *after;
+    double v;
+
+    skip_ws(p);
+    v = strtod(p->pos, &after);
+    if (after == p->pos) {
+        fail(p, "expected a number");
+        return 0.0;
+    }
+    p->pos = after;
+    return v;
+}
+
+static void skip_value(parser_t *p)
+{
+    skip_ws(p);
+    if (p->err || p->pos >= p->end) {
+        fail(p, "unexpected end");
+        return;
+    }
+
+    switch (*p->pos) {
+    case '"':
+        parse_string(p, NULL, 0);
+        break;
+    case '{':
+        p->pos++;
+        if (accept(p, '}')) {
+            break;
+        }
+        do {
+            parse_string(p, NULL, 0);
+            expect(p, ':');
+            skip_value(p);
+        } while (!p->err && accept(p, ','));
+        expect(p, '}');
+        break;
+    case '[':
+        p->pos++;
+        if (accept(p, ']')) {
+            break;
+        }
+        do {
+            skip_value(p);
+        } while (!p->err && accept(p, ','));
+        expect(p, ']');
+        break;
+    default:
+        if (isalpha((unsigned char)*p->pos)) {          // true, false, null
+            while (p->pos < p->end && isalpha((unsigned char)*p->pos)) {
+                p->pos++;
+            }
+        } else {
+            parse_number(p);
+        }
+        break;
+    }
+}
+
+static int16_t to_q8(double v)
+{
+    long q = lround(v * (1 << GESTURE_Q));
+
+    return (int16_t)((q > INT16_MAX) ? INT16_MAX : (q < INT16_MIN) ? INT16_MIN : q);
+}
+
+static void parse_point(parser_t *p, gesture_point_t *pt)
+{
+    char key[8];
+
+    pt->x = pt->y = 0;
+    expect(p, '{');
+    if (accept(p, '}')) {
+        return;
+    }
+    do {
+        parse_string(p, key, sizeof(key));
+        expect(p, ':');
+        if (strcmp(key, "x") == 0) {
+            pt->x = to_q8(parse_number(p));
+        } else if (strcmp(key, "y") == 0) {
+            pt->y = to_q8(parse_number(p));
+        } else {
+            skip_value(p);
+        }
+    } while (!p->err && accept(p, ','));
+    expect(p, '}');
+}
+
+static void parse_points(parser_t *p, wand_stroke_t *st)
+{
+    size_t cap = 0;
+
+    expect(p, '[');
+    if (accept(p, ']')) {
+        return;
+    }
+    do {
+        if (st->n == cap) {
+            cap = cap ? 2 * cap : 64;
+            gesture_point_t *grown = realloc(st->pts, cap * sizeof(*grown));
+
+            if (grown == NULL) {
+                fail(p, "out of memory");
+                return;
+            }
+            st->pts = grown;
+        }
+        parse_point(p, &st->pts[st->n++]);
+    } while (!p->err && accept(p, ','));
+    expect(p, ']');
+}
+
+static void parse_stroke(parser_t *p, wand_stroke_t *st)
+{
+    char key[16];
+
+    memset(st, 0, sizeof(*st));
+    expect(p, '{');
+    if (accept(p, '}')) {
+        return;
+    }
+    do {
+        parse_string(p, key, sizeof(key));
+        expect(p, ':');
+        if (strcmp(key, "index") == 0) {
+            st->index = (int)parse_number(p);
+        } else if (strcmp(key, "label") == 0) {
+            parse_string(p, st->label, sizeof(st->label));
+        } else if (strcmp(key, "strokePoints") == 0) {
+            parse_points(p, st);
+        } else {
+            skip_value(p);
+        }
+    } while (!p->err && accept(p, ','));
+    expect(p, '}');
+}
+
+static void parse_strokes(parser_t *p, wand_dataset_t *ds)
+{
+    size_t cap = 0;
+
+    expect(p, '[');
+    if (accept(p, ']')) {
+        return;
+    }
+    do {
+        if (ds->count == cap) {
+            cap = cap ? 2 * cap : 64;
+            wand_stroke_t *grown = realloc(ds->strokes, cap * sizeof(*grown));
+
+            if (grown == NULL) {
+                fail(p, "out of memory");
+                return;
+            }
+            ds->strokes = grown;
+        }
+        parse_stroke(p, &ds->strokes[ds->count++]);
+    } while (!p->err && accept(p, ','));
+    expect(p, ']');
+}
+
+static char *read_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    char *buf = NULL;
+    long size;
+
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+        buf = malloc((size_t)size + 1);
+        if (buf != NULL && fread(buf, 1, (size_t)size, f) == (size_t)size) {
+            buf[size] = '\0';
+            *len = (size_t)size;
+        } else {
+            free(buf);
+            buf = NULL;
+            fprintf(stderr, "%s: read failed\n", path);
+        }
+    }
+    fclose(f);
+    return buf;
+}
+
+int wand_json_load(const char *path, wand_dataset_t *ds)
+{
+    size_t len = 0;
+    char *text = read_file(path, &len);
+    char key[16];
+
+    memset(ds, 0, sizeof(*ds));
+    if (text == NULL) {
+        return -1;
+    }
+
+    parser_t p = { .s = text, .pos = text, .end = text + len };
+
+    expect(&p, '{');
+    if (!accept(&p, '}')) {
+        do {
+            parse_string(&p, key, sizeof(key));
+            expect(&p, ':');
+            if (strcmp(key, "strokes") == 0) {
+                parse_strokes(&p, ds);
+            } else {
+                skip_value(&p);
+            }
+        } while (!p.err && accept(&p, ','));
+        expect(&p, '}');
+    }
+
+    free(text);
+    if (p.err) {
+        fprintf(stderr, "%s: not a wand dataset\n", path);
+        wand_dataset_free(ds);
+        return -1;
+    }
+    return 0;
+}
+
+void wand_dataset_free(wand_dataset_t *ds)
+{
+    for (size_t i = 0; i < ds->count; i++) {
+        free(ds->strokes[i].pts);
+    }
+    free(ds->strokes);
+    memset(ds, 0, sizeof(*ds));
+}
@@ -0,0 +1,43 @@
+/* Host-side readers for the magic wand datasets, JSON or packed (.wpk)
+ *
+ *   {"strokes": [{"index": 0, "label": "b",
+ *                 "strokePoints": [{"x": 0.015625, "y": -0.0859375}, ...]}, ...]}
+ *
+ * Only the fields above are looked at, anything else is skipped. Points are
+ * converted to the Q8 gesture_point_t used by common/gesture (the data is
+ * quantised to 1/256, so the conversion is exact). An empty or missing
+ * label is kept as "", the tools treat those strokes as the reject class.
+ */
+#ifndef WAND_JSON_H
+#define WAND_JSON_H
+
+#include <stddef.h>
+
+#include "gesture.h"
+
+#define WAND_LABEL_MAX 16
+
+typedef struct {
+    int              index;
+    char             label[WAND_LABEL_MAX];
+    gesture_point_t *pts;
+    size_t           n;
+} wand_stroke_t;
+
+typedef struct {
+    wand_stroke_t *strokes;
+    size_t         count;
+} wand_dataset_t;
+
+// 0 on success, -1 with a message on stderr otherwise
+int wand_json_load(const char *path, wand_dataset_t *ds);
+
+// .wpk pack (common/gesture/stroke_pack.h), read through mmap; wand_data.c
+int wand_pack_load(const char *path, wand_dataset_t *ds);
+
+// Either of the above, chosen by the file's magic
+int wand_dataset_load(const char *path, wand_dataset_t *ds);
+
+void wand_dataset_free(wand_dataset_t *ds);
+
+#endif /* WAND_JSON_H */
@@ -0,0 +1,148 @@
+"""Packs the magic wand JSON datasets into the binary .wpk format.
+
+The layout is documented in common/gesture/stroke_pack.h, which also holds
+the C reader. Points become int16 Q8 (the data is quantised to 1/256, so
+this is lossless), stored as deltas of one byte per moving point and one
+byte per run of up to 16 repeated points. Coordinates that are all
+multiples of 2^n are stored >> n.
+
+    python wand_pack.py 100_b_strokes_combined.json \
+        ../wanddata_combined_preserve_classes.json --unique -o wand.wpk
+
+The pack can be embedded in firmware with generate_inc_file_for_target()
+and read in place from flash.
+"""
+import argparse
+import json
+import struct
+
+VERSION = 1
+Q = 8
+LABEL_LEN = 16
+UNLABELED = 0xFF
+HDR = struct.Struct("<4sBBBBHHI")
+ENTRY = struct.Struct("<IHHBBH")
+
+
+def load_strokes(paths):
+    """(index, label, [(x, y), ...]) in Q8 for every stroke of every file"""
+    strokes = []
+    for path in paths:
+        with open(path) as f:
+            for s in json.load(f)["strokes"]:
+                pts = [(round(p["x"] * (1 << Q)), round(p["y"] * (1 << Q)))
+                       for p in s["strokePoints"]]
+                strokes.append((s.get("index", len(strokes)), s.get("label", ""), pts))
+    return strokes
+
+
+def common_shift(strokes):
+    """Largest n <= 8 such that every coordinate is a multiple of 2^n"""
+    bits = 0
+    for _, _, pts in strokes:
+        for x, y in pts:
+            bits |= x | y
+    shift = 0
+    while shift < 8 and not bits & ((1 << (shift + 1)) - 1):
+        shift += 1
+    return shift
+
+
+def nibble_ok(d):
+    return -8 <= d <= 7
+
+
+def encode(pts, shift):
+    pts = [(x >> shift, y >> shift) for x, y in pts]
+    out = bytearray()
+    if not pts:
+        return out
+    out += struct.pack("<hh", *pts[0])
+    repeat = 0
+
+    def flush():
+        nonlocal repeat
+        while repeat > 0:
+            n = min(repeat, 16)
+            out.append(0x80 | (n - 1))
+            repeat -= n
+
+    for (px, py), (x, y) in zip(pts, pts[1:]):
+        dx, dy = x - px, y - py
+        if dx == 0 and dy == 0:
+            repeat += 1
+            continue
+        flush()
+        op = ((dx & 0xF) << 4) | (dy & 0xF)
+        # dx -8 would collide with the repeat ops, (0, 0) with the escape
+        if nibble_ok(dx) and nibble_ok(dy) and dx != -8:
+            out.append(op)
+        else:
+            out.append(0x00)
+            out += struct.pack("<hh", dx, dy)
+    flush()
+    return out
+
+
+def pack(strokes):
+    labels = sorted({label for _, label, _ in strokes if label})
+    if len(labels) >= UNLABELED:
+        raise SystemExit("too many labels")
+    for label in labels:
+        if len(label.encode()) >= LABEL_LEN:
+            raise SystemExit(f"label too long: {label!r}")
+    if len(strokes) > 0xFFFF:
+        raise SystemExit("too many strokes")
+
+    shift = common_shift(strokes)
+    data = bytearray()
+    index = bytearray()
+    for idx, label, pts in strokes:
+        enc = encode(pts, shift)
+        if len(pts) > 0xFFFF or len(enc) > 0xFFFF:
+            raise SystemExit(f"stroke {idx} is too long")
+        label_id = labels.index(label) if label else UNLABELED
+        index += ENTRY.pack(len(data), len(pts), idx & 0xFFFF, label_id, 0, len(enc))
+        data += enc
+
+    table = b"".join(label.encode().ljust(LABEL_LEN, b"\0") for label in labels)
+    data_at = HDR.size + len(table) + len(index)
+    hdr = HDR.pack(b"WAND", VERSION, Q, shift, len(labels), len(strokes), 0, data_at)
+    return hdr + table + index + data, shift
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack wand JSON datasets into a .wpk file")
+    parser.add_argument("inputs", nargs="+", help="JSON datasets")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--unique", action="store_true",
+                        help="drop strokes identical to an earlier one (points and label)")
+    args = parser.parse_args()
+
+    strokes = load_strokes(args.inputs)
+    total = len(strokes)
+    if args.unique:
+        seen = set()
+        unique = []
+        for s in strokes:
+            key = (s[1], tuple(s[2]))
+            if key not in seen:
+                seen.add(key)
+                unique.append(s)
+        strokes = unique
+
+    blob, shift = pack(strokes)
+    with open(args.output, "wb") as f:
+        f.write(blob)
+
+    json_size = 0
+    for path in args.inputs:
+        with open(path, "rb") as f:
+            json_size += len(f.read())
+    points = sum(len(p) for _, _, p in strokes)
+    print(f"{args.output}: {len(strokes)} of {total} strokes, {points} points, shift {shift}, "
+          f"{len(blob)} bytes ({json_size / len(blob):.0f}x smaller than the JSON)")
+
+
+if __name__ == "__main__":
+    main()
@@ -14,33 +14,34 @@
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/sys/byteorder.h>
 
+#include "adv_payload.h"
+
 // This is our device name from prj.conf
 #define DEVICE_NAME "Q2TRAPPY"
 #define DEVICE_NAME_LEN (sizeof(DEVICE_NAME) - 1)
 
 // This is the company ID that will be in the Manufacturer Specific Data
 #define COMPANY_ID 0x0059 // Nordic Semiconductor ASA
+#define GROUP_ID   0x01
+
+// Temperature to advertise, in centi-degrees (45.00 C)
+#define DEMO_TEMP_CENTI 4500
+
+/**
+ * Manufacturer Specific Data in the versioned payload format shared with the
+ * other firmware (common/adv_payload/adv_payload.h): header + one temperature.
+ */
+static uint8_t mfg_data[ADV_PAYLOAD_HDR_LEN + ADV_FIELD_TEMP_LEN];
 
-// Define Manufacturer Specific Data structure
-struct adv_mfg_data {
-	uint16_t company_id;
-	int16_t temperature;
-} __packed;
-typedef struct adv_mfg_data adv_mfg_data_t;
-
-// Initilaise data to be advertised
-static adv_mfg_data_t mfg_data = {
-	.company_id = COMPANY_ID,
-	.temperature = 45,
-};
 /**
  * Our advertisement data structure.
  * 
  * We include the device name and the manufacturer specific data (which includes specific company ID and temperature sensor value).
+ * The manufacturer data length is filled in once the payload is encoded.
  */
-static const struct bt_data ad[] = {
+static struct bt_data ad[] = {
 	BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
-	BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&mfg_data, sizeof(mfg_data)),
+	BT_DATA(BT_DATA_MANUFACTURER_DATA, mfg_data, 0),
 };
 
 /**
@@ -73,11 +74,21 @@ int main(void)
 	}
 
 	printk("Bluetooth initialized\n");
-	
-	printk("Element 1: T=0x%02x, L=0x%02x, V='C=0x%04x, T=%d'\n",
+
+	adv_payload_t payload;
+
+	adv_payload_init(&payload, mfg_data, sizeof(mfg_data), COMPANY_ID, GROUP_ID);
+	adv_payload_put_temp(&payload, 0, DEMO_TEMP_CENTI);
+	err = adv_payload_finish(&payload);
+	if (err < 0) {
+		printk("Payload encode failed (err %d)\n", err);
+		return 0;
+	}
+	ad[1].data_len = (uint8_t)err;
+
+	printk("Element 1: T=0x%02x, L=0x%02x, V='C=0x%04x, v%d, T=%d'\n",
        ad[1].type, ad[1].data_len,
-       ((adv_mfg_data_t *)ad[1].data)->company_id,
-       ((adv_mfg_data_t *)ad[1].data)->temperature);
+       sys_get_le16(&mfg_data[0]), mfg_data[2], DEMO_TEMP_CENTI);
 
 	err = bt_le_adv_start(adv_param, ad, ARRAY_SIZE(ad), NULL, 0);
 	if (err) {
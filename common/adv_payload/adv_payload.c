@@ -0,0 +1,151 @@
+/* Advertisement payload encoder, see adv_payload.h */
+#include "adv_payload.h"
+
+#include <errno.h>
+#include <string.h>
+
+static uint8_t *adv_reserve(adv_payload_t *p, size_t n)
+{
+    if (p->err) {
+        return NULL;
+    }
+    if (p->len + n > p->size) {
+        p->err = -ENOMEM;
+        return NULL;
+    }
+
+    uint8_t *out = &p->buf[p->len];
+
+    p->len += n;
+    return out;
+}
+
+static void put_le16(uint8_t *out, uint16_t v)
+{
+    out[0] = (uint8_t)(v & 0xFF);
+    out[1] = (uint8_t)(v >> 8);
+}
+
+void adv_payload_init(adv_payload_t *p, uint8_t *buf, size_t size,
+                      uint16_t company_id, uint8_t group_id)
+{
+    memset(p, 0, sizeof(*p));
+    p->buf  = buf;
+    p->size = size;
+
+    uint8_t *out = adv_reserve(p, ADV_PAYLOAD_HDR_LEN);
+
+    if (out != NULL) {
+        put_le16(out, company_id);
+        out[2] = ADV_PAYLOAD_VERSION;
+        out[3] = group_id;
+    }
+}
+
+void adv_payload_put_temp(adv_payload_t *p, uint8_t channel, int16_t temp_centi)
+{
+    int32_t delta = (int32_t)temp_centi - p->last_temp;
+    uint8_t *out;
+
+    if (channel > 0x0F) {
+        p->err = p->err ? p->err : -EINVAL;
+        return;
+    }
+
+    if (p->have_temp && delta >= INT8_MIN && delta <= INT8_MAX) {
+        out = adv_reserve(p, 2);
+        if (out == NULL) {
+            return;
+        }
+        out[0] = ADV_TAG(ADV_FIELD_TEMP_DELTA, channel);
+        out[1] = (uint8_t)(int8_t)delta;
+    } else {
+        out = adv_reserve(p, ADV_FIELD_TEMP_LEN);
+        if (out == NULL) {
+            return;
+        }
+        out[0] = ADV_TAG(ADV_FIELD_TEMP, channel);
+        put_le16(&out[1], (uint16_t)temp_centi);
+    }
+
+    p->last_temp = temp_centi;
+    p->have_temp = true;
+}
+
+void adv_payload_put_states(adv_payload_t *p, const uint8_t *states, uint8_t count)
+{
+    if (count == 0 || count > 0x0F) {
+        p->err = p->err ? p->err : -EINVAL;
+        return;
+    }
+
+    uint8_t *out = adv_reserve(p, ADV_FIELD_STATES_LEN(count));
+
+    if (out == NULL) {
+        return;
+    }
+
+    out[0] = ADV_TAG(ADV_FIELD_STATES, count);
+    memset(&out[1], 0, (count + 3) / 4);
+    for (uint8_t c = 0; c < count; c++) {
+        out[1 + c / 4] |= (uint8_t)((states[c] & 0x3) << (2 * (c % 4)));
+    }
+}
+
+void adv_payload_put_mv(adv_payload_t *p, uint8_t channel, int32_t mv)
+{
+    if (channel > 0x0F) {
+        p->err = p->err ? p->err : -EINVAL;
+        return;
+    }
+
+    uint8_t *out = adv_reserve(p, ADV_FIELD_MV_LEN);
+
+    if (out == NULL) {
+        return;
+    }
+
+    if (mv < 0) {
+        mv = 0;
+    } else if (mv > UINT16_MAX) {
+        mv = UINT16_MAX;
+    }
+    out[0] = ADV_TAG(ADV_FIELD_MV, channel);
+    put_le16(&out[1], (uint16_t)mv);
+}
+
+void adv_payload_put_flags(adv_payload_t *p, uint8_t flags)
+{
+    uint8_t *out = adv_reserve(p, ADV_FIELD_FLAGS_LEN);
+
+    if (out == NULL) {
+        return;
+    }
+
+    out[0] = ADV_TAG(ADV_FIELD_FLAGS, 0);
+    out[1] = flags;
+}
+
+void adv_payload_put_ext(adv_payload_t *p, uint8_t type, uint8_t idx,
+                         const uint8_t *data, uint8_t len)
+{
+    if (type < ADV_FIELD_EXT_FIRST || type > 0x0F || idx > 0x0F) {
+        p->err = p->err ? p->err : -EINVAL;
+        return;
+    }
+
+    uint8_t *out = adv_reserve(p, 2 + (size_t)len);
+
+    if (out == NULL) {
+        return;
+    }
+
+    out[0] = ADV_TAG(type, idx);
+    out[1] = len;
+    memcpy(&out[2], data, len);
+}
+
+int adv_payload_finish(const adv_payload_t *p)
+{
+    return p->err ? p->err : (int)p->len;
+}
@@ -0,0 +1,78 @@
+/* Versioned advertisement payload shared by all the firmware in this repo
+ * and decoded by the gateway (CW_1/CW_1/scanner/adv_payload.py).
+ *
+ * Manufacturer specific data, little-endian:
+ *
+ *   company_id  u16   (stripped by most BLE stacks before the app sees it)
+ *   version     u8    ADV_PAYLOAD_VERSION
+ *   group_id    u8
+ *   fields...         tag byte + value, until the end of the data
+ *
+ * Tag byte: high nibble = field type, low nibble = channel (or count for
+ * ADV_FIELD_STATES). Types below 0x8 have a size fixed by the type, so no
+ * length byte is spent on them. Types 0x8..0xF are followed by a u8 length,
+ * so a decoder can skip the ones it does not know.
+ *
+ * No Zephyr dependencies, builds for any target or a host compiler.
+ */
+#ifndef ADV_PAYLOAD_H
+#define ADV_PAYLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ADV_PAYLOAD_VERSION 1
+#define ADV_PAYLOAD_HDR_LEN 4       // company_id, version, group_id
+
+// Field types (tag high nibble)
+#define ADV_FIELD_TEMP       0x1    // i16 centi-degrees
+#define ADV_FIELD_TEMP_DELTA 0x2    // i8 centi-degrees relative to the previous temperature field
+#define ADV_FIELD_STATES     0x3    // low nibble = N channels, ceil(N/4) bytes, 2 bits each, channel 0 in bits 1:0
+#define ADV_FIELD_MV         0x4    // u16 sensor millivolts
+#define ADV_FIELD_FLAGS      0x5    // u8 device flags
+#define ADV_FIELD_EXT_FIRST  0x8    // 0x8..0xF: u8 length + data
+#define ADV_FIELD_HISTORY    0x8    // ext: CW_1 history block (CW_1/CW_1/src/history.h), low nibble = channels
+#define ADV_FIELD_MINUTE     0x9    // ext: u32 device minute counter, time reference for history blocks
+
+#define ADV_TAG(type, idx)   ((uint8_t)(((type) << 4) | ((idx) & 0x0F)))
+
+// Worst-case field sizes (tag included), for compile time budget checks
+#define ADV_FIELD_TEMP_LEN       3
+#define ADV_FIELD_MV_LEN         3
+#define ADV_FIELD_FLAGS_LEN      2
+#define ADV_FIELD_STATES_LEN(n)  (1 + ((n) + 3) / 4)
+
+// Encoder state - builds the payload in a caller provided buffer
+typedef struct {
+    uint8_t *buf;
+    size_t   size;
+    size_t   len;
+    int      err;           // first error, sticky
+    int16_t  last_temp;     // reference for the next delta
+    bool     have_temp;
+} adv_payload_t;
+
+void adv_payload_init(adv_payload_t *p, uint8_t *buf, size_t size,
+                      uint16_t company_id, uint8_t group_id);
+
+// Temperature of one channel, delta-encoded against the previous
+// temperature field when the difference fits in an i8
+void adv_payload_put_temp(adv_payload_t *p, uint8_t channel, int16_t temp_centi);
+
+// Two bit states of channels 0..count-1 (count 1..15)
+void adv_payload_put_states(adv_payload_t *p, const uint8_t *states, uint8_t count);
+
+// Sensor voltage, clamped to 0..65535 mV
+void adv_payload_put_mv(adv_payload_t *p, uint8_t channel, int32_t mv);
+
+void adv_payload_put_flags(adv_payload_t *p, uint8_t flags);
+
+// Length-prefixed field (type 0x8..0xF), for data older decoders may skip
+void adv_payload_put_ext(adv_payload_t *p, uint8_t type, uint8_t idx,
+                         const uint8_t *data, uint8_t len);
+
+// Bytes written, or a negative errno (-ENOMEM, -EINVAL) if any put failed
+int adv_payload_finish(const adv_payload_t *p);
+
+#endif /* ADV_PAYLOAD_H */
@@ -0,0 +1,232 @@
+/* Magic wand gesture recognition, see gesture.h */
+#include "gesture.h"
+
+#include <string.h>
+
+// Segment lengths carry 4 extra fraction bits over the Q8 input, and steps
+// are clamped so the squared length stays in 32 bits. The wand data spans
+// +-0.5, a step of 8.0 is far outside anything real.
+#define LEN_FRAC_BITS  4
+#define STEP_CLAMP     (8 << GESTURE_Q)
+
+#define DTW_INF        (GESTURE_DIST_MAX / 2)   // headroom for one more cost
+
+static uint32_t isqrt32(uint32_t v)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static int32_t clamp_step(int32_t d)
+{
+    return (d > STEP_CLAMP) ? STEP_CLAMP : (d < -STEP_CLAMP) ? -STEP_CLAMP : d;
+}
+
+static uint32_t seg_len(const gesture_point_t *a, const gesture_point_t *b)
+{
+    int32_t dx = clamp_step((int32_t)b->x - a->x);
+    int32_t dy = clamp_step((int32_t)b->y - a->y);
+
+    return isqrt32((uint32_t)(dx * dx + dy * dy) << (2 * LEN_FRAC_BITS));
+}
+
+// Rounds to nearest, halves away from zero
+static int32_t div_round(int32_t num, int32_t den)
+{
+    return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+// Points evenly spaced along the path, first and last points kept
+static void resample(const gesture_point_t *pts, size_t n, int16_t out[GESTURE_POINTS][2])
+{
+    uint64_t total = 0;
+
+    for (size_t i = 0; i + 1 < n; i++) {
+        total += seg_len(&pts[i], &pts[i + 1]);
+    }
+
+    out[0][0] = pts[0].x;
+    out[0][1] = pts[0].y;
+
+    int k = 1;
+    uint64_t walked = 0;    // path length up to pts[i]
+
+    for (size_t i = 0; i + 1 < n && k < GESTURE_POINTS - 1; i++) {
+        uint32_t seg = seg_len(&pts[i], &pts[i + 1]);
+
+        while (k < GESTURE_POINTS - 1) {
+            uint64_t target = total * (uint64_t)k / (GESTURE_POINTS - 1);
+
+            if (target > walked + seg) {
+                break;
+            }
+
+            int32_t t = (int32_t)(target - walked);
+            int32_t dx = (int32_t)pts[i + 1].x - pts[i].x;
+            int32_t dy = (int32_t)pts[i + 1].y - pts[i].y;
+
+            if (seg == 0) {
+                dx = dy = 0;
+            } else {
+                dx = div_round(clamp_step(dx) * t, (int32_t)seg);
+                dy = div_round(clamp_step(dy) * t, (int32_t)seg);
+            }
+            out[k][0] = (int16_t)(pts[i].x + dx);
+            out[k][1] = (int16_t)(pts[i].y + dy);
+            k++;
+        }
+        walked += seg;
+    }
+
+    // rounding can leave the last targets just past the end of the path
+    for (; k < GESTURE_POINTS; k++) {
+        out[k][0] = pts[n - 1].x;
+        out[k][1] = pts[n - 1].y;
+    }
+}
+
+void gesture_frame_from_points(const gesture_point_t *pts, size_t n, gesture_frame_t *out)
+{
+    int16_t rs[GESTURE_POINTS][2];
+    int32_t sum[2] = { 0, 0 };
+
+    memset(out, 0, sizeof(*out));
+    if (n == 0) {
+        return;
+    }
+
+    resample(pts, n, rs);
+
+    for (int k = 0; k < GESTURE_POINTS; k++) {
+        sum[0] += rs[k][0];
+        sum[1] += rs[k][1];
+    }
+
+    int32_t centre[2] = { div_round(sum[0], GESTURE_POINTS), div_round(sum[1], GESTURE_POINTS) };
+    int32_t extent = 0;
+
+    for (int k = 0; k < GESTURE_POINTS; k++) {
+        for (int c = 0; c < 2; c++) {
+            int32_t v = rs[k][c] - centre[c];
+
+            v = (v < 0) ? -v : v;
+            extent = (v > extent) ? v : extent;
+        }
+    }
+
+    if (extent == 0) {
+        return;
+    }
+
+    for (int k = 0; k < GESTURE_POINTS; k++) {
+        for (int c = 0; c < 2; c++) {
+            out->pt[k][c] = (int8_t)div_round((rs[k][c] - centre[c]) * 127, extent);
+        }
+    }
+}
+
+static uint32_t point_cost(const int8_t a[2], const int8_t b[2])
+{
+    int32_t dx = a[0] - b[0];
+    int32_t dy = a[1] - b[1];
+
+    return (uint32_t)((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+}
+
+static uint32_t min3(uint32_t a, uint32_t b, uint32_t c)
+{
+    uint32_t m = (a < b) ? a : b;
+
+    return (m < c) ? m : c;
+}
+
+uint32_t gesture_dtw(const gesture_frame_t *a, const gesture_frame_t *b, uint32_t abandon_above)
+{
+    uint32_t rows[2][GESTURE_POINTS];
+    uint32_t *prev = rows[0];
+    uint32_t *cur = rows[1];
+
+    // cells right of the band are never written, so they stay infinite
+    for (int j = 0; j < GESTURE_POINTS; j++) {
+        rows[0][j] = DTW_INF;
+        rows[1][j] = DTW_INF;
+    }
+
+    for (int i = 0; i < GESTURE_POINTS; i++) {
+        int lo = (i > GESTURE_DTW_BAND) ? i - GESTURE_DTW_BAND : 0;
+        int hi = (i + GESTURE_DTW_BAND < GESTURE_POINTS - 1) ? i + GESTURE_DTW_BAND
+                                                              : GESTURE_POINTS - 1;
+        uint32_t row_min = DTW_INF;
+
+        for (int j = lo; j <= hi; j++) {
+            uint32_t best;
+
+            if (i == 0 && j == 0) {
+                best = 0;
+            } else {
+                uint32_t left = (j > lo) ? cur[j - 1] : DTW_INF;
+                uint32_t diag = (j > 0) ? prev[j - 1] : DTW_INF;
+
+                best = min3(left, diag, prev[j]);
+            }
+
+            cur[j] = (best >= DTW_INF) ? DTW_INF : best + point_cost(a->pt[i], b->pt[j]);
+            row_min = (cur[j] < row_min) ? cur[j] : row_min;
+        }
+
+        // every path crosses every row and costs are never negative
+        if (row_min > abandon_above) {
+            return GESTURE_DIST_MAX;
+        }
+
+        uint32_t *tmp = prev;
+
+        prev = cur;
+        cur = tmp;
+    }
+
+    return prev[GESTURE_POINTS - 1];
+}
+
+int gesture_classify(const gesture_model_t *model, const gesture_frame_t *frame,
+                     uint32_t *distance)
+{
+    uint32_t best = GESTURE_DIST_MAX;
+    int label = GESTURE_REJECT;
+
+    for (uint16_t t = 0; t < model->count; t++) {
+        uint32_t d = gesture_dtw(frame, &model->templates[t].frame, best);
+
+        if (d < best) {
+            best = d;
+            label = model->templates[t].label;
+        }
+    }
+
+    if (distance != NULL) {
+        *distance = best;
+    }
+    return (best <= model->reject_distance) ? label : GESTURE_REJECT;
+}
+
+const char *gesture_label_name(const gesture_model_t *model, int label)
+{
+    if (label < 0 || label >= model->label_count) {
+        return "reject";
+    }
+    return model->labels[label];
+}
@@ -0,0 +1,66 @@
+/* Magic wand gesture recognition - fixed-point, no heap, no Zephyr
+ * dependencies, so the firmware and the host tools in MAGICWand/tools run
+ * the same code.
+ *
+ *   stroke points (Q8)  ->  gesture_frame_from_points()  ->  frame
+ *   frame + model       ->  gesture_classify()           ->  label / reject
+ *
+ * A frame is the stroke resampled to GESTURE_POINTS points evenly spaced
+ * along its path, centred on its centroid and scaled so its largest
+ * coordinate is +-127 (aspect ratio kept). Classification is nearest
+ * template under DTW with a Sakoe-Chiba band; templates that cannot beat
+ * the best distance so far are abandoned early, and a best distance above
+ * the model's reject_distance is reported as GESTURE_REJECT.
+ */
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define GESTURE_POINTS     32       // points per frame
+#define GESTURE_DTW_BAND   4        // max |i - j| of a DTW alignment
+#define GESTURE_Q          8        // stroke coordinates are Q8 (1/256 units)
+#define GESTURE_REJECT     (-1)
+
+#define GESTURE_DIST_MAX   UINT32_MAX
+
+// Stroke point in Q8, the wand data is already quantised to 1/256
+typedef struct {
+    int16_t x;
+    int16_t y;
+} gesture_point_t;
+
+typedef struct {
+    int8_t pt[GESTURE_POINTS][2];   // x, y
+} gesture_frame_t;
+
+typedef struct {
+    gesture_frame_t frame;
+    uint8_t         label;          // index into gesture_model_t.labels
+} gesture_template_t;
+
+typedef struct {
+    const gesture_template_t *templates;
+    uint16_t                  count;
+    uint32_t                  reject_distance;  // best distance above this is a reject
+    const char *const        *labels;
+    uint8_t                   label_count;
+} gesture_model_t;
+
+// Resamples and normalises a stroke of n >= 1 points. A stroke that never
+// moves gives an all-zero frame.
+void gesture_frame_from_points(const gesture_point_t *pts, size_t n, gesture_frame_t *out);
+
+// DTW distance (sum of L1 point distances along the best banded path).
+// Returns GESTURE_DIST_MAX as soon as it is certain to exceed abandon_above.
+uint32_t gesture_dtw(const gesture_frame_t *a, const gesture_frame_t *b, uint32_t abandon_above);
+
+// Label index of the nearest template, or GESTURE_REJECT. *distance (may be
+// NULL) gets the best distance, GESTURE_DIST_MAX for an empty model.
+int gesture_classify(const gesture_model_t *model, const gesture_frame_t *frame,
+                     uint32_t *distance);
+
+const char *gesture_label_name(const gesture_model_t *model, int label);
+
+#endif /* GESTURE_H */
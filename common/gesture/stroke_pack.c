@@ -0,0 +1,158 @@
+/* Packed wand stroke dataset reader, see stroke_pack.h */
+#include "stroke_pack.h"
+
+#include <errno.h>
+#include <string.h>
+
+#define OP_ESCAPE   0x00
+#define OP_REPEAT   0x80    // 0x80..0x8F
+
+static uint16_t get_le16(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t *in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+           ((uint32_t)in[3] << 24);
+}
+
+static int32_t nibble(uint8_t v)
+{
+    return (v & 0x8) ? (int32_t)v - 16 : (int32_t)v;
+}
+
+int stroke_pack_open(stroke_pack_t *p, const void *data, size_t size)
+{
+    const uint8_t *in = data;
+
+    memset(p, 0, sizeof(*p));
+    if (size < STROKE_PACK_HDR_LEN || memcmp(in, "WAND", 4) != 0 ||
+        in[4] != STROKE_PACK_VERSION || in[5] != GESTURE_Q || in[6] > 8) {
+        return -EINVAL;
+    }
+
+    p->base         = in;
+    p->size         = size;
+    p->shift        = in[6];
+    p->label_count  = in[7];
+    p->stroke_count = get_le16(&in[8]);
+
+    size_t index_at = STROKE_PACK_HDR_LEN + (size_t)p->label_count * STROKE_PACK_LABEL_LEN;
+    size_t data_at = get_le32(&in[12]);
+
+    if (index_at + (size_t)p->stroke_count * STROKE_PACK_INDEX_LEN > data_at || data_at > size) {
+        return -EBADMSG;
+    }
+    p->index = in + index_at;
+    p->data  = in + data_at;
+    return 0;
+}
+
+// Entry of stroke, checked against the pack size
+static const uint8_t *index_entry(const stroke_pack_t *p, uint16_t stroke, int *err)
+{
+    if (stroke >= p->stroke_count) {
+        *err = -EINVAL;
+        return NULL;
+    }
+
+    const uint8_t *e = p->index + (size_t)stroke * STROKE_PACK_INDEX_LEN;
+    size_t end = (size_t)(p->data - p->base) + get_le32(&e[0]) + get_le16(&e[10]);
+
+    if (end > p->size || (get_le16(&e[4]) > 0 && get_le16(&e[10]) < 4)) {
+        *err = -EBADMSG;
+        return NULL;
+    }
+    return e;
+}
+
+int stroke_pack_info(const stroke_pack_t *p, uint16_t stroke, stroke_info_t *info)
+{
+    int err = 0;
+    const uint8_t *e = index_entry(p, stroke, &err);
+
+    if (e == NULL) {
+        return err;
+    }
+    info->points = get_le16(&e[4]);
+    info->index  = get_le16(&e[6]);
+    info->label  = e[8];
+    return 0;
+}
+
+const char *stroke_pack_label(const stroke_pack_t *p, uint8_t label)
+{
+    if (label >= p->label_count) {
+        return "";
+    }
+
+    const char *name = (const char *)p->base + STROKE_PACK_HDR_LEN +
+                       (size_t)label * STROKE_PACK_LABEL_LEN;
+
+    // the converter always terminates, a damaged pack may not
+    return (name[STROKE_PACK_LABEL_LEN - 1] == '\0') ? name : "";
+}
+
+int stroke_pack_read_begin(const stroke_pack_t *p, uint16_t stroke, stroke_reader_t *rd)
+{
+    int err = 0;
+    const uint8_t *e = index_entry(p, stroke, &err);
+
+    memset(rd, 0, sizeof(*rd));
+    if (e == NULL) {
+        return err;
+    }
+    rd->pos   = p->data + get_le32(&e[0]);
+    rd->end   = rd->pos + get_le16(&e[10]);
+    rd->left  = get_le16(&e[4]);
+    rd->shift = p->shift;
+    rd->first = true;
+    return 0;
+}
+
+int stroke_pack_read(stroke_reader_t *rd, gesture_point_t *out, size_t max)
+{
+    size_t n = 0;
+
+    while (n < max && rd->left > 0) {
+        if (rd->first) {
+            if (rd->end - rd->pos < 4) {
+                return -EBADMSG;
+            }
+            rd->x = (int16_t)get_le16(&rd->pos[0]);
+            rd->y = (int16_t)get_le16(&rd->pos[2]);
+            rd->pos += 4;
+            rd->first = false;
+        } else if (rd->repeat > 0) {
+            rd->repeat--;
+        } else {
+            if (rd->pos >= rd->end) {
+                return -EBADMSG;
+            }
+
+            uint8_t op = *rd->pos++;
+
+            if (op == OP_ESCAPE) {
+                if (rd->end - rd->pos < 4) {
+                    return -EBADMSG;
+                }
+                rd->x += (int16_t)get_le16(&rd->pos[0]);
+                rd->y += (int16_t)get_le16(&rd->pos[2]);
+                rd->pos += 4;
+            } else if ((op & 0xF0) == OP_REPEAT) {
+                rd->repeat = op & 0x0F;     // this point is the first repeat
+            } else {
+                rd->x += nibble(op >> 4);
+                rd->y += nibble(op & 0x0F);
+            }
+        }
+
+        out[n].x = (int16_t)(rd->x * (1 << rd->shift));
+        out[n].y = (int16_t)(rd->y * (1 << rd->shift));
+        n++;
+        rd->left--;
+    }
+    return (int)n;
+}
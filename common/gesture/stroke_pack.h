@@ -0,0 +1,89 @@
+/* Packed wand stroke dataset (.wpk), built by MAGICWand/tools/wand_pack.py
+ *
+ * Read in place from memory - an mmap'd file on the host, a const array in
+ * flash on the device - and decoded one point at a time, no heap.
+ *
+ * Little-endian layout:
+ *
+ *   header   16 bytes
+ *     magic        "WAND"
+ *     version  u8  STROKE_PACK_VERSION
+ *     q        u8  fraction bits of the decoded points (GESTURE_Q)
+ *     shift    u8  stored coordinates are the decoded ones >> shift
+ *     labels   u8  label count
+ *     strokes  u16 stroke count
+ *     reserved u16
+ *     data     u32 offset of the stroke data from the start of the pack
+ *   labels   labels x 16 bytes, NUL padded
+ *   index    strokes x 12 bytes
+ *     offset   u32 stroke data, relative to data
+ *     points   u16
+ *     index    u16 "index" of the stroke in the source dataset
+ *     label    u8  STROKE_PACK_UNLABELED for none
+ *     reserved u8
+ *     length   u16 encoded bytes
+ *   stroke data
+ *     first point  i16 x, i16 y
+ *     then one op per change:
+ *       0x00           i16 dx, i16 dy follow
+ *       0x80..0x8F     (low nibble + 1) repeats of the previous point
+ *       anything else  dx = high nibble, dy = low nibble, 4 bit signed
+ */
+#ifndef STROKE_PACK_H
+#define STROKE_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gesture.h"
+
+#define STROKE_PACK_VERSION     1
+#define STROKE_PACK_HDR_LEN     16
+#define STROKE_PACK_LABEL_LEN   16
+#define STROKE_PACK_INDEX_LEN   12
+#define STROKE_PACK_UNLABELED   0xFF
+
+typedef struct {
+    const uint8_t *base;
+    size_t         size;
+    const uint8_t *index;
+    const uint8_t *data;
+    uint16_t       stroke_count;
+    uint8_t        label_count;
+    uint8_t        shift;
+} stroke_pack_t;
+
+typedef struct {
+    uint16_t points;
+    uint16_t index;
+    uint8_t  label;         // STROKE_PACK_UNLABELED or < label_count
+} stroke_info_t;
+
+// Decoder state of one stroke
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+    int32_t        x, y;    // previous point, stored units
+    uint16_t       left;    // points still to decode
+    uint8_t        repeat;  // pending repeats of (x, y)
+    uint8_t        shift;
+    bool           first;
+} stroke_reader_t;
+
+// 0, or -EINVAL if data is not a pack, -EBADMSG if its tables do not fit
+int stroke_pack_open(stroke_pack_t *p, const void *data, size_t size);
+
+// 0, or -EINVAL for a stroke past the end, -EBADMSG if it lies outside the pack
+int stroke_pack_info(const stroke_pack_t *p, uint16_t stroke, stroke_info_t *info);
+
+// Label name, "" for STROKE_PACK_UNLABELED or an unknown label
+const char *stroke_pack_label(const stroke_pack_t *p, uint8_t label);
+
+int stroke_pack_read_begin(const stroke_pack_t *p, uint16_t stroke, stroke_reader_t *rd);
+
+// Decodes up to max points (Q8). Returns the count, 0 at the end of the
+// stroke, -EBADMSG if the encoding is cut short or malformed.
+int stroke_pack_read(stroke_reader_t *rd, gesture_point_t *out, size_t max);
+
+#endif /* STROKE_PACK_H */
@@ -0,0 +1,177 @@
+/* Streaming stroke segmentation, see stroke_seg.h */
+#include "stroke_seg.h"
+
+#include <string.h>
+
+_Static_assert((STROKE_RING_SLOTS & (STROKE_RING_SLOTS - 1)) == 0,
+               "STROKE_RING_SLOTS must be a power of two");
+_Static_assert(STROKE_SEG_MAX_POINTS > STROKE_SEG_PREROLL + 1,
+               "stroke buffer must hold the pre-roll");
+
+#define STEP_MAX    4095    // keeps the scaled step in 16 bits
+
+const stroke_seg_cfg_t stroke_seg_default_cfg = {
+    .start_energy = STROKE_SEG_ENERGY(5) / 2,   // 2.5 Q8 units per point
+    .stop_energy  = STROKE_SEG_ENERGY(3) / 2,
+    .hold         = 12,
+    .min_points   = 12,
+    .max_points   = 400,
+};
+
+void stroke_ring_init(stroke_ring_t *r)
+{
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->overruns = 0;
+}
+
+bool stroke_ring_put(stroke_ring_t *r, gesture_point_t p)
+{
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (head - tail == STROKE_RING_SLOTS) {
+        r->overruns++;
+        return false;
+    }
+
+    r->slot[head & (STROKE_RING_SLOTS - 1)] = p;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return true;
+}
+
+static bool ring_get(stroke_ring_t *r, gesture_point_t *p)
+{
+    unsigned int tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+    if (tail == head) {
+        return false;
+    }
+
+    *p = r->slot[tail & (STROKE_RING_SLOTS - 1)];
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+void stroke_seg_init(stroke_seg_t *s, const stroke_seg_cfg_t *cfg)
+{
+    memset(s, 0, sizeof(*s));
+    s->cfg = (cfg != NULL) ? *cfg : stroke_seg_default_cfg;
+}
+
+// Keeps every other point, every stored point then stands for twice as
+// many input points
+static void thin(stroke_seg_t *s)
+{
+    for (uint16_t i = 1; 2 * i < s->len; i++) {
+        s->pts[i] = s->pts[2 * i];
+    }
+    s->len = (s->len + 1) / 2;
+    s->last_moving /= 2;
+    s->stride *= 2;
+}
+
+static void store(stroke_seg_t *s, gesture_point_t p)
+{
+    if (s->skip > 0) {
+        s->skip--;
+        return;
+    }
+    if (s->len == STROKE_SEG_MAX_POINTS) {
+        thin(s);
+    }
+    s->pts[s->len++] = p;
+    s->skip = s->stride - 1;
+}
+
+static void start_stroke(stroke_seg_t *s, gesture_point_t p)
+{
+    s->active = true;
+    s->len    = 0;
+    s->stride = 1;
+    s->skip   = 0;
+    s->seen   = 0;
+    s->below  = 0;
+
+    for (uint8_t i = 0; i < s->pre_len; i++) {
+        store(s, s->pre[i]);
+    }
+    s->pre_len = 0;
+    store(s, p);
+    s->last_moving = s->len - 1;
+}
+
+static void remember_idle(stroke_seg_t *s, gesture_point_t p)
+{
+    if (s->pre_len == STROKE_SEG_PREROLL) {
+        memmove(&s->pre[0], &s->pre[1], (STROKE_SEG_PREROLL - 1) * sizeof(s->pre[0]));
+        s->pre_len--;
+    }
+    s->pre[s->pre_len++] = p;
+}
+
+bool stroke_seg_push(stroke_seg_t *s, gesture_point_t p, gesture_frame_t *frame)
+{
+    int32_t step = 0;
+
+    if (s->have_prev) {
+        int32_t dx = (int32_t)p.x - s->prev.x;
+        int32_t dy = (int32_t)p.y - s->prev.y;
+
+        step = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+        step = (step > STEP_MAX) ? STEP_MAX : step;
+    }
+    s->prev = p;
+    s->have_prev = true;
+
+    // energy += (16 * step - energy) / 4
+    s->energy = (uint16_t)(s->energy + (16 * step - (int32_t)s->energy) / 4);
+
+    if (!s->active) {
+        if (s->energy > s->cfg.start_energy) {
+            start_stroke(s, p);
+        } else {
+            remember_idle(s, p);
+        }
+        return false;
+    }
+
+    s->seen++;
+    store(s, p);
+
+    if (s->energy >= s->cfg.stop_energy) {
+        s->below = 0;
+        s->last_moving = s->len - 1;
+    } else if (s->below < UINT8_MAX) {
+        s->below++;
+    }
+
+    if (s->below < s->cfg.hold && s->seen < s->cfg.max_points) {
+        return false;
+    }
+
+    // trailing idle points are not part of the gesture
+    uint16_t n = s->last_moving + 1;
+
+    s->active = false;
+    if (n < s->cfg.min_points) {
+        s->dropped++;
+        return false;
+    }
+
+    gesture_frame_from_points(s->pts, n, frame);
+    return true;
+}
+
+bool stroke_seg_poll(stroke_seg_t *s, stroke_ring_t *r, gesture_frame_t *frame)
+{
+    gesture_point_t p;
+
+    while (ring_get(r, &p)) {
+        if (stroke_seg_push(s, p, frame)) {
+            return true;
+        }
+    }
+    return false;
+}
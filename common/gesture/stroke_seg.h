@@ -0,0 +1,87 @@
+/* Streaming stroke segmentation for live wand input
+ *
+ *   sensor  -> stroke_ring_put()   (producer, e.g. the sample callback)
+ *   thread  -> stroke_seg_poll()   -> gesture_frame_t -> classifier queue
+ *
+ * Points are consumed one at a time. Motion energy is an exponential
+ * average of the L1 step between points; it crossing start_energy starts a
+ * stroke (with a few points of pre-roll, so the onset is not lost), and it
+ * staying below stop_energy for hold points ends it. Idle points at both
+ * ends are trimmed, strokes shorter than min_points are dropped as noise,
+ * and the stroke is emitted as a fixed-size frame as soon as the hold
+ * expires, so recognition latency is hold points after the end of the
+ * gesture rather than the end of the recording.
+ *
+ * All storage is in the structs: a long stroke is thinned 2:1 in place when
+ * its buffer fills, so RAM stays at STROKE_SEG_MAX_POINTS points whatever
+ * the stroke length. No heap, no Zephyr dependencies.
+ */
+#ifndef STROKE_SEG_H
+#define STROKE_SEG_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gesture.h"
+
+#define STROKE_RING_SLOTS      64      // power of two
+#define STROKE_SEG_MAX_POINTS  128     // stroke buffer, thinned 2:1 when full
+#define STROKE_SEG_PREROLL     4       // idle points kept in front of a stroke
+
+// Energies are the averaged L1 step in Q8 point units, scaled by 16
+#define STROKE_SEG_ENERGY(q8)  ((uint16_t)((q8) * 16))
+
+typedef struct {
+    uint16_t start_energy;  // idle -> stroke above this
+    uint16_t stop_energy;   // counts towards the hold below this
+    uint8_t  hold;          // points below stop_energy that end a stroke
+    uint8_t  min_points;    // shorter strokes (after trimming) are dropped
+    uint16_t max_points;    // input points after which a stroke is cut
+} stroke_seg_cfg_t;
+
+// Single producer, single consumer point ring
+typedef struct {
+    gesture_point_t  slot[STROKE_RING_SLOTS];
+    atomic_uint      head;      // written by the producer
+    atomic_uint      tail;      // written by the consumer
+    uint32_t         overruns;  // points dropped on a full ring (producer side)
+} stroke_ring_t;
+
+typedef struct {
+    stroke_seg_cfg_t cfg;
+    gesture_point_t  prev;
+    bool             have_prev;
+    bool             active;
+    uint16_t         energy;
+    uint8_t          below;         // consecutive points below stop_energy
+    gesture_point_t  pre[STROKE_SEG_PREROLL];
+    uint8_t          pre_len;
+    gesture_point_t  pts[STROKE_SEG_MAX_POINTS];
+    uint16_t         len;
+    uint16_t         last_moving;   // pts index of the last point that moved
+    uint16_t         stride;        // input points per stored point
+    uint16_t         skip;          // input points until the next stored one
+    uint16_t         seen;          // input points of the current stroke
+    uint32_t         dropped;       // strokes shorter than min_points
+} stroke_seg_t;
+
+// Thresholds tuned on the MAGICWand recordings (MAGICWand/tools/seg_replay.c)
+extern const stroke_seg_cfg_t stroke_seg_default_cfg;
+
+void stroke_ring_init(stroke_ring_t *r);
+
+// Producer side. False (and an overrun counted) when the ring is full.
+bool stroke_ring_put(stroke_ring_t *r, gesture_point_t p);
+
+// cfg NULL for stroke_seg_default_cfg
+void stroke_seg_init(stroke_seg_t *s, const stroke_seg_cfg_t *cfg);
+
+// Feeds one point. True when it completed a stroke, which is in *frame.
+bool stroke_seg_push(stroke_seg_t *s, gesture_point_t p, gesture_frame_t *frame);
+
+// Consumer side: drains the ring through stroke_seg_push() up to the first
+// completed stroke. True with *frame set, false once the ring is empty.
+bool stroke_seg_poll(stroke_seg_t *s, stroke_ring_t *r, gesture_frame_t *frame);
+
+#endif /* STROKE_SEG_H */
@@ -12,6 +12,8 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/adc.h>
 
+#include "adv_payload.h"
+
 /******************* Configuration Definitions ********************/
 #define SAMPLE_INTERVAL_MS   1000   
 #define REPORT_INTERVAL_MS   60000  
@@ -19,30 +21,43 @@
 #define DEVICE_NAME          "Louie Lab"
 #define DEVICE_NAME_LEN      (sizeof(DEVICE_NAME) - 1)
 #define COMPANY_ID           0x0059 
-#define TEMP_THRESHOLD_LIMIT 24.5f
+#define TEMP_THRESHOLD_CENTI 2450   // 24.50C
+#define HISTORY_LEN          60     // 1 min of 1 Hz samples
+
+// Sampling workqueue - the ADC reads get their own cooperative thread instead
+// of queueing behind BT host work on the system workqueue
+#define SAMPLE_WQ_PRIORITY   K_PRIO_COOP(2)
+#define SAMPLE_WQ_STACK_SIZE 1024   // unmeasured first guess, size it from the reported stack peak
+#define SAMPLE_LATE_US       1000   // timer -> ADC read delay counted as late
 /******************* Hardware Specifications ********************/
 static const struct adc_dt_spec adc_channel = ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
 static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(DT_ALIAS(led0), gpios);
 
 /******************* BLE Data Structures ********************/
-struct adv_mfg_data {
-    uint16_t company_id;   
-    uint8_t  group_id;     
-    int16_t  temperature;  
-    int32_t  voltage;      
-} __packed;
-typedef struct adv_mfg_data adv_mfg_data_t;
-
-static struct adv_mfg_data adv_mfg_data = {
-    .company_id = COMPANY_ID,
-    .group_id = MY_GROUP_NUMBER,
-};
+// Versioned payload (common/adv_payload): temperature and sensor voltage
+#define ADV_MFG_DATA_LEN (ADV_PAYLOAD_HDR_LEN + ADV_FIELD_TEMP_LEN + ADV_FIELD_MV_LEN)
+
+static uint8_t adv_mfg_data[ADV_MFG_DATA_LEN];
 
-static const struct bt_data ad[] = {
+static struct bt_data ad[] = {
     BT_DATA(BT_DATA_NAME_COMPLETE, DEVICE_NAME, DEVICE_NAME_LEN),
-    BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&adv_mfg_data, sizeof(adv_mfg_data)),
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, adv_mfg_data, 0),
 };
 
+static void adv_fill(int16_t temp_centi, int32_t mv)
+{
+    adv_payload_t payload;
+
+    adv_payload_init(&payload, adv_mfg_data, sizeof(adv_mfg_data), COMPANY_ID, MY_GROUP_NUMBER);
+    adv_payload_put_temp(&payload, 0, temp_centi);
+    adv_payload_put_mv(&payload, 0, mv);
+
+    int len = adv_payload_finish(&payload);
+    if (len > 0) {
+        ad[1].data_len = (uint8_t)len;
+    }
+}
+
 #define BT_ADV_INTERVAL 0x1F40
 
 // Now it's time for advertisement parameters
@@ -53,17 +68,62 @@ static const struct bt_le_adv_param *adv_param = BT_LE_ADV_PARAM(
 	NULL
 );
 
-/******************* Global Variables (Volatile for safety) ********************/
+/******************* Global Variables ********************/
+// Sampling and reporting run on two cooperative workqueue threads and neither
+// handler blocks while it touches the history, so it needs no locking.
+
+// 1 min history in centi-degrees with a running sum, O(1) per sample
+typedef struct {
+    int16_t  buffer[HISTORY_LEN];
+    int32_t  sum_centi;
+    uint16_t index;
+    uint16_t valid_samples;
+} temp_avg_t;
+
 static int16_t adc_buf; 
-static volatile float temp_history[60];
-static volatile int sample_count = 0;
-static volatile int32_t latest_voltage_mv = 0;
+static temp_avg_t temp_avg;
+static int32_t latest_voltage_mv = 0;
 static bool adc_setup_done = false; 
 
+K_THREAD_STACK_DEFINE(sample_wq_stack, SAMPLE_WQ_STACK_SIZE);
+static struct k_work_q sample_wq;
+
+// Timer expiry -> sample_work_handler start
+static volatile uint32_t sample_trigger_cyc;
+static uint32_t sample_late_count;
+static uint32_t sample_delay_max_us;
+
+static void temp_avg_add(temp_avg_t *avg, int16_t temp_centi)
+{
+    if (avg->valid_samples < HISTORY_LEN) {
+        avg->valid_samples++;
+    } else {
+        avg->sum_centi -= avg->buffer[avg->index];
+    }
+    avg->buffer[avg->index] = temp_centi;
+    avg->sum_centi += temp_centi;
+
+    avg->index = (avg->index + 1) % HISTORY_LEN;
+}
+
+static int16_t temp_avg_get(const temp_avg_t *avg)
+{
+    if (avg->valid_samples == 0) {
+        return 0;
+    }
+    return (int16_t)(avg->sum_centi / (int32_t)avg->valid_samples);
+}
+
 
 /******************* Task 1: Data Processing (1Hz) ********************/
 static void sample_work_handler(struct k_work *work)
 {
+    uint32_t delay_us = k_cyc_to_us_floor32(k_cycle_get_32() - sample_trigger_cyc);
+
+    if (delay_us > SAMPLE_LATE_US) {
+        sample_late_count++;
+    }
+    sample_delay_max_us = MAX(sample_delay_max_us, delay_us);
 
     if (!adc_is_ready_dt(&adc_channel)) return;
     if (!adc_setup_done) {
@@ -81,10 +141,9 @@ static void sample_work_handler(struct k_work *work)
         int32_t mv = (int32_t)adc_buf;
         adc_raw_to_millivolts_dt(&adc_channel, &mv);
 
-        // Update globals directly
+        // LM335: 10 mV/K, so mV * 10 is centi-kelvin
         latest_voltage_mv = mv;
-        temp_history[sample_count % 60] = ((float)mv / 10.0f) - 273.15f;
-        sample_count++;
+        temp_avg_add(&temp_avg, (int16_t)((mv * 10) - 27315));
     }
 }
 K_WORK_DEFINE(sample_worker, sample_work_handler);
@@ -93,37 +152,40 @@ K_WORK_DEFINE(sample_worker, sample_work_handler);
 /******************* Task 2: Communication Thread (1/60Hz) ********************/
 static void report_work_handler(struct k_work *work)
 {
-    float sum = 0.0f;
-    
-    for (int i = 0; i < 60; i++) {
-        sum += temp_history[i];
-    }
-
-    float avg_temp = sum / 60.0f;
+    int16_t temp_scaled = temp_avg_get(&temp_avg);
 
     // --- ALERT LOGIC ---
-    if (avg_temp > TEMP_THRESHOLD_LIMIT) { 
+    if (temp_scaled > TEMP_THRESHOLD_CENTI) { 
 		gpio_pin_toggle_dt(&led);
-        printk("!!! ALERT: TEMPERATURE EXCEEDED 28C (Current: %.2f C) !!!\n", (double)avg_temp);
+        printk("!!! ALERT: TEMPERATURE EXCEEDED %d.%02dC (Current: %d.%02d C) !!!\n",
+               TEMP_THRESHOLD_CENTI / 100, TEMP_THRESHOLD_CENTI % 100,
+               temp_scaled / 100, abs(temp_scaled % 100));
     }
 
-    int16_t temp_scaled = (int16_t)(avg_temp * 100);
-
-    // Prepare data for transmission (Big Endian)
-    adv_mfg_data.temperature = sys_cpu_to_be16(temp_scaled);
-    adv_mfg_data.voltage = sys_cpu_to_be32(latest_voltage_mv);
+    // Prepare data for transmission
+    adv_fill(temp_scaled, latest_voltage_mv);
     
     // Update the BLE packet
     bt_le_adv_update_data(ad, ARRAY_SIZE(ad), NULL, 0);
 
     printk("[REPORTER] Min Avg: %d.%02d C | Voltage: %d mV\n", 
             temp_scaled / 100, abs(temp_scaled % 100), latest_voltage_mv);
+
+    size_t unused = 0;
+    k_thread_stack_space_get(k_work_queue_thread_get(&sample_wq), &unused);
+    printk("[SAMPLE] late (>%d us): %u | max delay: %u us | stack peak: %u/%d\n",
+           SAMPLE_LATE_US, sample_late_count, sample_delay_max_us,
+           (unsigned int)(SAMPLE_WQ_STACK_SIZE - unused), SAMPLE_WQ_STACK_SIZE);
 }
 K_WORK_DEFINE(report_worker, report_work_handler);
 
 
 /******************* Timers ********************/
-static void sample_timer_cb(struct k_timer *timer) { k_work_submit(&sample_worker); }
+static void sample_timer_cb(struct k_timer *timer)
+{
+    sample_trigger_cyc = k_cycle_get_32();
+    k_work_submit_to_queue(&sample_wq, &sample_worker);
+}
 static void report_timer_cb(struct k_timer *timer) { k_work_submit(&report_worker); }
 
 K_TIMER_DEFINE(sample_timer, sample_timer_cb, NULL);
@@ -137,14 +199,21 @@ int main(void)
     if (!gpio_is_ready_dt(&led)) return -EIO;
     gpio_pin_configure_dt(&led, GPIO_OUTPUT_INACTIVE);
 
+    const struct k_work_queue_config sample_wq_cfg = { .name = "sample_wq" };
+
+    k_work_queue_init(&sample_wq);
+    k_work_queue_start(&sample_wq, sample_wq_stack, K_THREAD_STACK_SIZEOF(sample_wq_stack),
+                       SAMPLE_WQ_PRIORITY, &sample_wq_cfg);
+
     if (bt_enable(NULL)) return -1;
-    if (bt_le_adv_start(adv_param, ad, ARRAY_SIZE(ad), NULL, 0)) return -1; 
+    adv_fill(0, 0);
 
 	if (bt_le_adv_start(adv_param, ad, ARRAY_SIZE(ad), NULL, 0)) {
         printk("Advertising failed to start\n");
         return -1;
     }
 
+    k_timer_start(&sample_timer, K_MSEC(SAMPLE_INTERVAL_MS), K_MSEC(SAMPLE_INTERVAL_MS));
     k_timer_start(&report_timer, K_MSEC(REPORT_INTERVAL_MS), K_MSEC(REPORT_INTERVAL_MS));
 
     return 0;
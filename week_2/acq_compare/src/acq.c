@@ -0,0 +1,366 @@
+/* acq.c - ADC acquisition with a runtime-selectable trigger strategy
+ *
+ * One k_timer and one acquisition thread serve all strategies. The timer
+ * ISR only timestamps the trigger and hands it on (k_work, k_poll signal or
+ * semaphore), the ADC is always read in thread context.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/spinlock.h>
+
+#include "acq.h"
+
+#define ACQ_STACK_SIZE      1024
+#define ACQ_PRIORITY        K_PRIO_PREEMPT(7)  /* poll and async strategies */
+#define ACQ_PRIORITY_HIGH   K_PRIO_COOP(2)     /* dedicated-thread strategy */
+#define ACQ_ADC_TIMEOUT_MS  100
+
+/* acq_mode value while nothing runs */
+#define ACQ_IDLE            ACQ_STRATEGY_COUNT
+
+static const struct adc_dt_spec *acq_spec;
+static acq_sample_cb_t acq_cb;
+static int16_t acq_buf;
+static struct adc_sequence acq_seq = {
+	.buffer = &acq_buf,
+	.buffer_size = sizeof(acq_buf),
+};
+
+static atomic_t acq_mode = ATOMIC_INIT(ACQ_IDLE);
+static atomic_t acq_overruns;
+static uint32_t acq_period_ms;
+static uint32_t acq_period_cyc;
+
+/* Cycle counter at the last timer expiry */
+static volatile uint32_t acq_trigger_cyc;
+
+/* Statistics, written by the strategy context and read by acq_stats_get() */
+static struct k_spinlock acq_lock;
+static struct acq_stats acq_stats;
+static uint32_t acq_last_sample_cyc;
+static bool acq_have_last;
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+static k_thread_runtime_stats_t acq_usage_start;
+#endif
+
+static void acq_timer_handler(struct k_timer *timer);
+static void acq_work_handler(struct k_work *work);
+static void acq_thread(void *p1, void *p2, void *p3);
+
+K_TIMER_DEFINE(acq_timer, acq_timer_handler, NULL);
+K_WORK_DEFINE(acq_work, acq_work_handler);
+K_SEM_DEFINE(acq_tick_sem, 0, 1);   /* ACQ_THREAD trigger */
+K_SEM_DEFINE(acq_wake_sem, 0, 1);   /* leaves the idle state */
+K_SEM_DEFINE(acq_idle_sem, 0, 1);   /* thread reached the idle state */
+K_THREAD_DEFINE(acq_tid, ACQ_STACK_SIZE, acq_thread, NULL, NULL, NULL,
+		ACQ_PRIORITY, 0, 0);
+
+/* ACQ_ASYNC_POLL: timer trigger and ADC completion */
+static struct k_poll_signal acq_tick_sig = K_POLL_SIGNAL_INITIALIZER(acq_tick_sig);
+static struct k_poll_signal acq_adc_sig = K_POLL_SIGNAL_INITIALIZER(acq_adc_sig);
+static struct k_poll_event acq_tick_evt = K_POLL_EVENT_INITIALIZER(
+	K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &acq_tick_sig);
+static struct k_poll_event acq_adc_evt = K_POLL_EVENT_INITIALIZER(
+	K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &acq_adc_sig);
+
+static const char *const acq_names[ACQ_STRATEGY_COUNT] = {
+	[ACQ_POLL]       = "poll",
+	[ACQ_TIMER_WORK] = "timer+work",
+	[ACQ_ASYNC_POLL] = "async+k_poll",
+	[ACQ_THREAD]     = "thread",
+};
+
+const char *acq_strategy_name(enum acq_strategy strategy)
+{
+	return (strategy < ACQ_STRATEGY_COUNT) ? acq_names[strategy] : "idle";
+}
+
+/* Bin n holds [2^(n-1), 2^n) us, see ACQ_JITTER_BINS */
+static unsigned int acq_jitter_bin(uint32_t us)
+{
+	unsigned int bin = (us == 0) ? 0 : 32 - __builtin_clz(us);
+
+	return MIN(bin, ACQ_JITTER_BINS - 1);
+}
+
+/* Books one read that was triggered at trigger_cyc and finished with err */
+static void acq_record(uint32_t trigger_cyc, int err)
+{
+	uint32_t now = k_cycle_get_32();
+	k_spinlock_key_t key = k_spin_lock(&acq_lock);
+
+	if (err < 0) {
+		acq_stats.errors++;
+		k_spin_unlock(&acq_lock, key);
+		return;
+	}
+
+	uint32_t latency = k_cyc_to_us_floor32(now - trigger_cyc);
+
+	acq_stats.samples++;
+	acq_stats.latency_sum_us += latency;
+	acq_stats.latency_min_us = MIN(acq_stats.latency_min_us, latency);
+	acq_stats.latency_max_us = MAX(acq_stats.latency_max_us, latency);
+
+	if (acq_have_last) {
+		int32_t interval = k_cyc_to_us_floor32(now - acq_last_sample_cyc);
+		int32_t diff = interval - (int32_t)(acq_period_ms * USEC_PER_MSEC);
+		uint32_t jitter = (diff < 0) ? -diff : diff;
+
+		acq_stats.jitter_hist[acq_jitter_bin(jitter)]++;
+		acq_stats.jitter_max_us = MAX(acq_stats.jitter_max_us, jitter);
+	}
+	acq_last_sample_cyc = now;
+	acq_have_last = true;
+
+	k_spin_unlock(&acq_lock, key);
+
+	if (acq_cb) {
+		int32_t mv = acq_buf;
+
+		if (adc_raw_to_millivolts_dt(acq_spec, &mv) < 0) {
+			mv = 0;
+		}
+		acq_cb(acq_buf, mv);
+	}
+}
+
+static void acq_read_sync(uint32_t trigger_cyc)
+{
+	int err = adc_read(acq_spec->dev, &acq_seq);
+
+	if (err < 0) {
+		printk("ADC read failed (err=%d)\n", err);
+	}
+	acq_record(trigger_cyc, err);
+}
+
+static void acq_read_async(uint32_t trigger_cyc)
+{
+	unsigned int signaled;
+	int result;
+	int err;
+
+	k_poll_signal_reset(&acq_adc_sig);
+	acq_adc_evt.state = K_POLL_STATE_NOT_READY;
+
+	err = adc_read_async(acq_spec->dev, &acq_seq, &acq_adc_sig);
+	if (err == 0) {
+		err = k_poll(&acq_adc_evt, 1, K_MSEC(ACQ_ADC_TIMEOUT_MS));
+	}
+	if (err == 0) {
+		k_poll_signal_check(&acq_adc_sig, &signaled, &result);
+		err = result;
+	}
+	if (err < 0) {
+		printk("ADC async read failed (err=%d)\n", err);
+	}
+	acq_record(trigger_cyc, err);
+}
+
+/* ISR: timestamp and hand over, never touch the ADC here */
+static void acq_timer_handler(struct k_timer *timer)
+{
+	unsigned int signaled;
+	int result;
+
+	ARG_UNUSED(timer);
+	acq_trigger_cyc = k_cycle_get_32();
+
+	switch (atomic_get(&acq_mode)) {
+	case ACQ_TIMER_WORK:
+		/* 0 = still queued from the previous expiry */
+		if (k_work_submit(&acq_work) == 0) {
+			atomic_inc(&acq_overruns);
+		}
+		break;
+	case ACQ_ASYNC_POLL:
+		k_poll_signal_check(&acq_tick_sig, &signaled, &result);
+		if (signaled) {
+			atomic_inc(&acq_overruns);
+		}
+		k_poll_signal_raise(&acq_tick_sig, 0);
+		break;
+	case ACQ_THREAD:
+		if (k_sem_count_get(&acq_tick_sem) > 0) {
+			atomic_inc(&acq_overruns);
+		}
+		k_sem_give(&acq_tick_sem);
+		break;
+	default:
+		break;
+	}
+}
+
+/* System workqueue */
+static void acq_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (atomic_get(&acq_mode) == ACQ_TIMER_WORK) {
+		acq_read_sync(acq_trigger_cyc);
+	}
+}
+
+static void acq_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		uint32_t start;
+
+		/* every blocking call below may be cut short by acq_stop(),
+		 * so the mode is checked again before reading the ADC
+		 */
+		switch (atomic_get(&acq_mode)) {
+		case ACQ_POLL:
+			start = k_cycle_get_32();
+			k_sleep(K_MSEC(acq_period_ms));
+			if (atomic_get(&acq_mode) == ACQ_POLL) {
+				/* the trigger is when the sleep should have ended */
+				acq_read_sync(start + acq_period_cyc);
+			}
+			break;
+
+		case ACQ_ASYNC_POLL:
+			acq_tick_evt.state = K_POLL_STATE_NOT_READY;
+			k_poll(&acq_tick_evt, 1, K_FOREVER);
+			k_poll_signal_reset(&acq_tick_sig);
+			if (atomic_get(&acq_mode) == ACQ_ASYNC_POLL) {
+				acq_read_async(acq_trigger_cyc);
+			}
+			break;
+
+		case ACQ_THREAD:
+			k_sem_take(&acq_tick_sem, K_FOREVER);
+			if (atomic_get(&acq_mode) == ACQ_THREAD) {
+				acq_read_sync(acq_trigger_cyc);
+			}
+			break;
+
+		default:
+			/* idle, also while ACQ_TIMER_WORK runs on the workqueue */
+			k_sem_reset(&acq_tick_sem);
+			k_poll_signal_reset(&acq_tick_sig);
+			k_sem_give(&acq_idle_sem);
+			k_sem_take(&acq_wake_sem, K_FOREVER);
+			break;
+		}
+	}
+}
+
+int acq_init(const struct adc_dt_spec *spec, acq_sample_cb_t cb)
+{
+	int err;
+
+	if (!adc_is_ready_dt(spec)) {
+		printk("ADC %s is not ready\n", spec->dev->name);
+		return -EIO;
+	}
+
+	err = adc_channel_setup_dt(spec);
+	if (err < 0) {
+		printk("ADC channel setup failed (err=%d)\n", err);
+		return err;
+	}
+
+	err = adc_sequence_init_dt(spec, &acq_seq);
+	if (err < 0) {
+		printk("ADC sequence init failed (err=%d)\n", err);
+		return err;
+	}
+
+	acq_spec = spec;
+	acq_cb = cb;
+	return 0;
+}
+
+void acq_stop(void)
+{
+	k_sem_reset(&acq_idle_sem);
+
+	int mode = atomic_set(&acq_mode, ACQ_IDLE);
+
+	k_timer_stop(&acq_timer);
+
+	if (mode == ACQ_TIMER_WORK) {
+		struct k_work_sync sync;
+
+		k_work_cancel_sync(&acq_work, &sync);
+	} else if (mode != ACQ_IDLE) {
+		/* wake the thread from whatever it blocks on */
+		k_wakeup(acq_tid);
+		k_sem_give(&acq_tick_sem);
+		k_poll_signal_raise(&acq_tick_sig, 0);
+		if (k_sem_take(&acq_idle_sem, K_MSEC(acq_period_ms + ACQ_ADC_TIMEOUT_MS)) != 0) {
+			printk("acq: %s did not stop\n", acq_strategy_name(mode));
+		}
+	}
+}
+
+int acq_start(enum acq_strategy strategy, uint32_t period_ms)
+{
+	if (acq_spec == NULL) {
+		return -ENODEV;
+	}
+	if (strategy >= ACQ_STRATEGY_COUNT || period_ms == 0) {
+		return -EINVAL;
+	}
+
+	acq_stop();
+
+	k_spinlock_key_t key = k_spin_lock(&acq_lock);
+
+	memset(&acq_stats, 0, sizeof(acq_stats));
+	acq_stats.latency_min_us = UINT32_MAX;
+	acq_have_last = false;
+	acq_period_ms = period_ms;
+	acq_period_cyc = k_ms_to_cyc_ceil32(period_ms);
+	k_spin_unlock(&acq_lock, key);
+	atomic_clear(&acq_overruns);
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	k_thread_runtime_stats_all_get(&acq_usage_start);
+#endif
+
+	k_thread_priority_set(acq_tid, (strategy == ACQ_THREAD) ? ACQ_PRIORITY_HIGH : ACQ_PRIORITY);
+	atomic_set(&acq_mode, strategy);
+
+	if (strategy != ACQ_POLL) {
+		k_timer_start(&acq_timer, K_MSEC(period_ms), K_MSEC(period_ms));
+	}
+	if (strategy != ACQ_TIMER_WORK) {
+		k_sem_give(&acq_wake_sem);
+	}
+	return 0;
+}
+
+void acq_stats_get(struct acq_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&acq_lock);
+
+	*out = acq_stats;
+	k_spin_unlock(&acq_lock, key);
+
+	out->overruns = atomic_get(&acq_overruns);
+	if (out->samples == 0) {
+		out->latency_min_us = 0;
+	}
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	k_thread_runtime_stats_t now;
+
+	/* CPU-wide stats: execution_cycles counts idle + non-idle,
+	 * total_cycles only non-idle
+	 */
+	k_thread_runtime_stats_all_get(&now);
+	out->busy_cycles = now.total_cycles - acq_usage_start.total_cycles;
+	out->total_cycles = now.execution_cycles - acq_usage_start.execution_cycles;
+#endif
+}
@@ -0,0 +1,59 @@
+/* acq.h - ADC acquisition with a runtime-selectable trigger strategy
+ *
+ * Puts the trigger models of task1 (polling), task3 (k_timer -> k_work) and
+ * task4 (adc_read_async + k_poll) behind one interface, plus a dedicated
+ * high-priority thread, so they can be compared on the same board and build.
+ *
+ * Every strategy records:
+ *   - trigger -> sample latency (trigger = timer expiry, or the end of the
+ *     k_sleep for polling; sample = adc_read completed)
+ *   - a histogram of |sample interval - period| (jitter)
+ *   - CPU busy time, from the kernel's thread runtime statistics
+ */
+#ifndef ACQ_H_
+#define ACQ_H_
+
+#include <stdint.h>
+#include <zephyr/drivers/adc.h>
+
+enum acq_strategy {
+	ACQ_POLL,        /* acquisition thread: k_sleep(period) then adc_read */
+	ACQ_TIMER_WORK,  /* k_timer ISR submits a k_work, adc_read on the system workqueue */
+	ACQ_ASYNC_POLL,  /* k_timer raises a signal, thread k_polls it, adc_read_async + k_poll */
+	ACQ_THREAD,      /* k_timer gives a semaphore to a cooperative high-priority thread */
+	ACQ_STRATEGY_COUNT,
+};
+
+/* Jitter bin 0 counts errors below 1 us, bin n counts [2^(n-1), 2^n) us,
+ * the last bin everything above.
+ */
+#define ACQ_JITTER_BINS 12
+
+struct acq_stats {
+	uint32_t samples;
+	uint32_t errors;          /* failed ADC reads */
+	uint32_t overruns;        /* trigger fired while the previous one was still pending */
+	uint32_t latency_min_us;
+	uint32_t latency_max_us;
+	uint64_t latency_sum_us;
+	uint32_t jitter_max_us;
+	uint32_t jitter_hist[ACQ_JITTER_BINS];
+	uint64_t busy_cycles;     /* non-idle CPU cycles since acq_start() */
+	uint64_t total_cycles;    /* all CPU cycles since acq_start() */
+};
+
+/* Called for every sample in the context of the active strategy, keep it short */
+typedef void (*acq_sample_cb_t)(int16_t raw, int32_t mv);
+
+int acq_init(const struct adc_dt_spec *spec, acq_sample_cb_t cb);
+
+/* Stops the running strategy, clears the statistics and starts strategy
+ * with one sample every period_ms.
+ */
+int acq_start(enum acq_strategy strategy, uint32_t period_ms);
+void acq_stop(void);
+
+void acq_stats_get(struct acq_stats *out);
+const char *acq_strategy_name(enum acq_strategy strategy);
+
+#endif /* ACQ_H_ */
@@ -0,0 +1,139 @@
+/* main.c - Lab Activity 2 - Trigger strategy comparison
+ *
+ * Runs the sampling styles of Task 1 (polling), Task 3 (k_timer -> k_work)
+ * and Task 4/5 (adc_read_async + k_poll), plus a dedicated high-priority
+ * thread, one after the other on the same build (see acq.h).
+ *
+ * Each strategy runs for ROUND_MS (Button 1 / sw0 skips to the next one),
+ * then its latency, jitter and CPU load are printed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/gpio.h>
+
+#include "acq.h"
+
+#define SAMPLE_PERIOD_MS  10
+#define ROUND_MS          10000
+
+/* LM335: 10 mV/K, 30 C = 303.15 K */
+#define TEMP_THRESHOLD_MV 3032
+
+/* LED */
+#define LED0_NODE DT_ALIAS(led0)
+#if !DT_NODE_HAS_STATUS(LED0_NODE, okay)
+#error "Unsupported board: led0 devicetree alias is not defined"
+#endif
+static const struct gpio_dt_spec led0 = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
+
+/* Button (sw0), optional */
+#define SW0_NODE DT_ALIAS(sw0)
+#if DT_NODE_HAS_STATUS(SW0_NODE, okay)
+static const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(SW0_NODE, gpios);
+static struct gpio_callback button_cb_data;
+#endif
+
+/* ADC channel */
+static const struct adc_dt_spec adc_channel =
+	ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+
+K_SEM_DEFINE(button_sem, 0, 1);
+
+static atomic_t last_mv;
+
+#if DT_NODE_HAS_STATUS(SW0_NODE, okay)
+static void button_pressed_handler(const struct device *dev, struct gpio_callback *cb,
+				   uint32_t pins)
+{
+	k_sem_give(&button_sem);
+}
+#endif
+
+/* Runs in the context of the active strategy: no printing here, it would
+ * show up in the latency being measured
+ */
+static void on_sample(int16_t raw, int32_t mv)
+{
+	ARG_UNUSED(raw);
+	atomic_set(&last_mv, mv);
+	gpio_pin_set_dt(&led0, mv > TEMP_THRESHOLD_MV);
+}
+
+static void print_report(enum acq_strategy strategy, const struct acq_stats *st)
+{
+	printk("[%s] %u samples, %u errors, %u overruns, last %d mV\n",
+	       acq_strategy_name(strategy), st->samples, st->errors, st->overruns,
+	       (int)atomic_get(&last_mv));
+
+	if (st->samples > 0) {
+		printk("  latency us: min %u avg %u max %u\n", st->latency_min_us,
+		       (uint32_t)(st->latency_sum_us / st->samples), st->latency_max_us);
+	}
+
+	/* bin n holds [2^(n-1), 2^n) us, labelled with its upper bound */
+	printk("  jitter us (max %u):", st->jitter_max_us);
+	for (int i = 0; i < ACQ_JITTER_BINS - 1; i++) {
+		printk(" <%u:%u", 1U << i, st->jitter_hist[i]);
+	}
+	printk(" >=%u:%u\n", 1U << (ACQ_JITTER_BINS - 2), st->jitter_hist[ACQ_JITTER_BINS - 1]);
+
+	if (st->total_cycles > 0) {
+		uint32_t busy = (uint32_t)(st->busy_cycles * 10000U / st->total_cycles);
+
+		printk("  cpu busy %u.%02u %%\n", busy / 100, busy % 100);
+	}
+}
+
+int main(void)
+{
+	int err;
+	enum acq_strategy strategy = ACQ_POLL;
+	struct acq_stats st;
+
+	printk("Lab Activity 2 - Trigger strategy comparison, %u ms period\n",
+	       SAMPLE_PERIOD_MS);
+
+	if (!gpio_is_ready_dt(&led0)) {
+		printk("LED device not ready\n");
+		return 0;
+	}
+	err = gpio_pin_configure_dt(&led0, GPIO_OUTPUT_INACTIVE);
+	if (err < 0) {
+		printk("LED configure failed (err=%d)\n", err);
+		return 0;
+	}
+
+#if DT_NODE_HAS_STATUS(SW0_NODE, okay)
+	if (gpio_is_ready_dt(&button)) {
+		gpio_pin_configure_dt(&button, GPIO_INPUT);
+		gpio_pin_interrupt_configure_dt(&button, GPIO_INT_EDGE_TO_ACTIVE);
+		gpio_init_callback(&button_cb_data, button_pressed_handler, BIT(button.pin));
+		gpio_add_callback(button.port, &button_cb_data);
+	}
+#endif
+
+	err = acq_init(&adc_channel, on_sample);
+	if (err < 0) {
+		return 0;
+	}
+
+	while (1) {
+		err = acq_start(strategy, SAMPLE_PERIOD_MS);
+		if (err < 0) {
+			printk("acq_start(%s) failed (err=%d)\n", acq_strategy_name(strategy), err);
+			return 0;
+		}
+
+		/* round ends after ROUND_MS or on a button press */
+		k_sem_take(&button_sem, K_MSEC(ROUND_MS));
+
+		acq_stats_get(&st);
+		acq_stop();
+		print_report(strategy, &st);
+
+		strategy = (strategy + 1) % ACQ_STRATEGY_COUNT;
+	}
+}
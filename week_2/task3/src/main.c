@@ -20,6 +20,13 @@
 #define USE_TIMER_EVENT_DRIVEN  1
 #define SAMPLE_PERIOD_MS        500
 
+/* Event-driven mode: sampling workqueue, so the ADC read does not queue
+ * behind other work (e.g. Bluetooth host) on the system workqueue
+ */
+#define SAMPLE_WQ_PRIORITY      K_PRIO_COOP(2)
+#define SAMPLE_WQ_STACK_SIZE    1024   /* unmeasured first guess, size it from the printed stack peak */
+#define SAMPLE_LATE_US          1000   /* timer -> work delay counted as late */
+
 /* LED (Task 2 optional – keep compatible with Task 1/2) */
 #define LED0_NODE DT_ALIAS(led0)
 #if !DT_NODE_HAS_STATUS(LED0_NODE, okay)
@@ -102,11 +109,35 @@ static int read_and_print_temperature(float *out_temp_c)
 static struct k_timer sample_timer;
 static struct k_work  sample_work;
 
+K_THREAD_STACK_DEFINE(sample_wq_stack, SAMPLE_WQ_STACK_SIZE);
+static struct k_work_q sample_wq;
+
+/* Jitter: delay from timer expiry to the work handler */
+static volatile uint32_t sample_trigger_cyc;
+static uint32_t sample_late_count;
+static uint32_t sample_delay_max_us;
+
 /* Runs in workqueue context (safe place to call adc_read) */
 static void sample_work_handler(struct k_work *work)
 {
 	ARG_UNUSED(work);
+
+	uint32_t delay_us = k_cyc_to_us_floor32(k_cycle_get_32() - sample_trigger_cyc);
+
+	if (delay_us > SAMPLE_LATE_US) {
+		sample_late_count++;
+	}
+	sample_delay_max_us = MAX(sample_delay_max_us, delay_us);
+
 	read_and_print_temperature(NULL);
+
+	/* peak stack use, needs CONFIG_INIT_STACKS and CONFIG_THREAD_STACK_INFO */
+	size_t unused = 0;
+
+	k_thread_stack_space_get(k_work_queue_thread_get(&sample_wq), &unused);
+	printk("delay=%u us (max %u us, %u late) | stack peak: %u/%d\n",
+	       delay_us, sample_delay_max_us, sample_late_count,
+	       (unsigned int)(SAMPLE_WQ_STACK_SIZE - unused), SAMPLE_WQ_STACK_SIZE);
 	/* TODO: call read_and_print_temperature(NULL); */
 }
 
@@ -114,7 +145,8 @@ static void sample_work_handler(struct k_work *work)
 static void sample_timer_handler(struct k_timer *timer)
 {
 	ARG_UNUSED(timer);
-	k_work_submit(&sample_work);
+	sample_trigger_cyc = k_cycle_get_32();
+	k_work_submit_to_queue(&sample_wq, &sample_work);
 	/* TODO: submit the work item (k_work_submit) */
 }
 #endif
@@ -140,6 +172,13 @@ int main(void)
 	/* TODO: initialise work + timer, start timer */
 	printk("Mode = TIMER (event-driven)\n");
 
+    /* Start the sampling workqueue thread */
+    const struct k_work_queue_config sample_wq_cfg = { .name = "sample_wq" };
+
+    k_work_queue_init(&sample_wq);
+    k_work_queue_start(&sample_wq, sample_wq_stack, K_THREAD_STACK_SIZEOF(sample_wq_stack),
+                       SAMPLE_WQ_PRIORITY, &sample_wq_cfg);
+
     /* Initialize the work item with the function to run */
     k_work_init(&sample_work, sample_work_handler);
 